@@ -26,20 +26,34 @@ int main() {
             return -1;
         }
         
-        // Main application loop
+        // Background jobs post an empty message to end the wait below
+        app.SetWakeCallback([] { ::PostMessage(g_hwnd, WM_NULL, 0, 0); });
+
+        // Main application loop: sleep until input, a wake-up or the pacer's next tick
         bool done = false;
         while (!done) {
+            DWORD timeout = static_cast<DWORD>(app.FrameWaitTimeout().count());
+            if (timeout > 0)
+                ::MsgWaitForMultipleObjectsEx(0, nullptr, timeout, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+
             MSG msg;
+            bool received = false;
             while (::PeekMessage(&msg, nullptr, 0U, 0U, PM_REMOVE)) {
                 ::TranslateMessage(&msg);
                 ::DispatchMessage(&msg);
                 
                 if (msg.message == WM_QUIT)
                     done = true;
+                received = true;
             }
+            if (received)
+                app.RequestFrame();
             
             if (done)
                 break;
+
+            if (!app.FrameDue())
+                continue;
             
             // Start ImGui frame
             StartImGuiFrame();
@@ -49,6 +63,7 @@ int main() {
             if (display_size.x <= 0.0f || display_size.y <= 0.0f) {
                 // Skip rendering this frame
                 PresentFrame(); // Optional: might still need to call this for the swap chain
+                app.FrameSkipped(); // counts as a frame, or the pacer keeps it due and the loop spins
                 continue;
             }
             
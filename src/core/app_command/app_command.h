@@ -7,6 +7,7 @@
 #include <filesystem>
 
 #include "../types.h"
+#include "../conversion_job/conversion_job.h"
 #include <lib90b/non_iid.h>
 
 struct OpenProjectCommand {
@@ -43,25 +44,27 @@ struct ConvertAndRunNonIidTestCommand {
     double minValue;
     double maxValue;
     std::filesystem::path* outputFile;
-    std::string* result;
+    SharedText* result;
     NonIidParsedResults* nonIidParsedResults;
     TestTimer* testTimer;
+    NonIidProgress* progress;
 };
 
 struct RunNonIidTestCommand {
     std::filesystem::path inputFile;
     std::filesystem::path*outputFile;
-    std::string* result;
+    SharedText* result;
     NonIidParsedResults* nonIidParsedResults;
 
     TestTimer* testTimer;
+    NonIidProgress* progress;
 };
 
 struct RunRestartTestCommand {
     double minEntropy;
     std::filesystem::path inputFile;
     std::filesystem::path* outputFile;
-    std::string* result;
+    SharedText* result;
 
     TestTimer* testTimer;
 };
@@ -75,6 +78,10 @@ struct FindPassingDecimationCommand {
     TestTimer* testTimer;
 };
 
+struct ConvertFilesCommand {
+    std::shared_ptr<ConversionJob> job;     // one pool job per file
+};
+
 using AppCommand = std::variant<
     OpenProjectCommand,
     SaveProjectCommand,
@@ -85,7 +92,8 @@ using AppCommand = std::variant<
     ConvertAndRunNonIidTestCommand,
     RunNonIidTestCommand,
     RunRestartTestCommand,
-    FindPassingDecimationCommand
+    FindPassingDecimationCommand,
+    ConvertFilesCommand
 >;
 
 class CommandQueue {
@@ -1,5 +1,6 @@
 
 #include <iostream>
+#include <optional>
 #include <string>
 #include <filesystem>
 
@@ -7,10 +8,78 @@
 
 #include "config.h"
 #include "application.h"
-#include "../data/find_first_passing_decimation/find_first_passing_decimation.h"
 
 namespace fs = std::filesystem;
 
+namespace {
+    // Where one test keeps its results inside an OE; null where it has none
+    struct TestFields {
+        fs::path* sampleFile = nullptr;             // the converted region, sub-histograms only
+        fs::path* outputFile = nullptr;
+        SharedText* result = nullptr;
+        NonIidParsedResults* parsed = nullptr;
+        TestTimer* timer = nullptr;
+        NonIidProgress* progress = nullptr;
+    };
+
+    // A test job's own copy of those fields, which the executor writes to
+    struct TestOutputs {
+        fs::path sampleFile;
+        fs::path outputFile;
+        SharedText result;
+        NonIidParsedResults parsed;
+        TestTimer timer;
+        NonIidProgress progress;
+    };
+
+    using TestLocator = std::function<std::optional<TestFields>(OperationalEnvironment&)>;
+
+    std::optional<TestFields> StatisticNonIidFields(OperationalEnvironment& oe) {
+        auto& stat = oe.statisticData;
+        return TestFields{ nullptr, &stat.nonIidResultFilePath, &stat.nonIidResult, &stat.nonIidParsedResults,
+                           &stat.nonIidTestTimer, &stat.nonIidProgress };
+    }
+
+    std::optional<TestFields> StatisticRestartFields(OperationalEnvironment& oe) {
+        auto& stat = oe.statisticData;
+        return TestFields{ nullptr, &stat.restartResultFilePath, &stat.restartResult, nullptr,
+                           &stat.restartTestTimer, nullptr };
+    }
+
+    std::optional<TestFields> MainHistogramFields(OperationalEnvironment& oe) {
+        auto& hist = oe.heuristicData.mainHistogram;
+        return TestFields{ nullptr, &hist.nonIidResultFilePath, &hist.nonIidResult, &hist.nonIidParsedResults,
+                           &hist.testTimer, &hist.nonIidProgress };
+    }
+
+    TestLocator SubHistogramFields(int subHistIndex) {
+        return [subHistIndex](OperationalEnvironment& oe) -> std::optional<TestFields> {
+            for (auto& sub : oe.heuristicData.mainHistogram.subHists) {
+                if (sub.subHistIndex != subHistIndex) continue;
+                return TestFields{ &sub.nonIidSampleFilePath, &sub.nonIidResultFilePath, &sub.nonIidResult,
+                                   &sub.nonIidParsedResults, &sub.testTimer, &sub.nonIidProgress };
+            }
+            return std::nullopt;
+        };
+    }
+
+    // The UI names a test by the address of its timer; from here on it is found
+    // by OE id and position, which stay valid when the project changes
+    std::optional<std::pair<uint64_t, TestLocator>> LocateTest(Project& project, const TestTimer* timer) {
+        for (auto& oe : project.operationalEnvironments) {
+            auto& stat = oe.statisticData;
+            auto& hist = oe.heuristicData.mainHistogram;
+            if (timer == &stat.nonIidTestTimer) return std::make_pair(oe.id, TestLocator(StatisticNonIidFields));
+            if (timer == &stat.restartTestTimer) return std::make_pair(oe.id, TestLocator(StatisticRestartFields));
+            if (timer == &hist.testTimer) return std::make_pair(oe.id, TestLocator(MainHistogramFields));
+            for (const auto& sub : hist.subHists) {
+                if (timer == &sub.testTimer) return std::make_pair(oe.id, SubHistogramFields(sub.subHistIndex));
+            }
+        }
+        return std::nullopt;
+    }
+}
+
 bool Application::Initialize() {
     fs::path baseDir = fs::current_path();
 
@@ -34,6 +103,9 @@ bool Application::Initialize() {
 }
 
 void Application::Update() {
+    PublishNotifications();
+    PublishJobs();
+
     AppCommand cmd;
     while (commandQueue.Pop(cmd)) {
         std::visit([this](auto&& command) {
@@ -53,191 +125,227 @@ void Application::Update() {
                 dataManager.DeleteOE(currentProject, command.oeIndex, config);
                 uiManager.OnProjectChanged(currentProject);
             } else if constexpr (std::is_same_v<T, ProcessHistogramCommand>) {
-                GetThreadPool().Enqueue([this, cmd = command] {
-                    try {
-                        auto& oe = currentProject.operationalEnvironments[cmd.oeIndex];
-
-                        // 1. Convert decimal file first
-                        lib90b::EntropyInputData entropyData;
-                        if (!oe.heuristicData.mainHistogram.heuristicFilePath.empty()) {
-                            if (!dataManager.ConvertDecimalFile(
-                                    oe.heuristicData.mainHistogram.heuristicFilePath,
-                                    oe.heuristicData.mainHistogram.convertedFilePath
-                                    )) 
-                            {
-                                uiManager.PushNotification("Failed to convert file for statistical tests.", 5.0f, ImVec4(1,0,0,1));
-                                return;
-                            }
-                        } else {
-                            uiManager.PushNotification("No raw file uploaded to convert.", 5.0f, ImVec4(1,0,0,1));
-                            return;
-                        }
-
-                        // 2. Process histogram
-                        dataManager.processHistogramForProject(
-                            currentProject,
-                            cmd.oeIndex,
-                            GetThreadPool(),
-                            [this](const std::string& msg, float duration, ImVec4 color) {
-                                uiManager.PushNotification(msg, duration, color);
-                            }
-                        );
-
-                        uiManager.PushNotification("Histogram processing completed.", 3.0f, ImVec4(0,1,0,1));
-                    } catch (const std::exception& e) {
-                        uiManager.PushNotification(std::string("Histogram processing failed: ") + e.what(), 5.0f, ImVec4(1,0,0,1));
-                    }
-                });
-            } else if constexpr (std::is_same_v<T, ConvertAndRunNonIidTestCommand>) {
-                GetThreadPool().Enqueue([this, cmd = command] {
-                    try {
-                        // Step 1: Convert
-                        uiManager.PushNotification("Converting sub-histogram...", 3.0f, ImVec4(0,0.5,1,1));
-                        
-                        if (!dataManager.ConvertDecimalFile(
-                                cmd.inputFile,
-                                *cmd.convertedFilePath,
-                                cmd.minValue,
-                                cmd.maxValue,
-                                cmd.subHistIndex)) 
-                        {
-                            uiManager.PushNotification("Failed to convert file.", 5.0f, ImVec4(1,0,0,1));
-                            return;
-                        }
-                        
-                        // Step 2: Run test
-                        uiManager.PushNotification("Running Non-IID test...", 3.0f, ImVec4(0,0.5,1,1));
-                        
-                        std::string linuxPath = toWslCommandPath(*cmd.convertedFilePath);
-                        std::string wslCmd = "wsl ea_non_iid -v " + linuxPath;
-
-                        cmd.testTimer->StartTestsTimer();
-
-                        std::string output = executeCommand(wslCmd);
-                        
-                        std::string resultFilename = cmd.convertedFilePath->stem().string() + "_nonIidResult.txt";
-                        std::filesystem::path logFile = cmd.convertedFilePath->parent_path() / resultFilename;
-                        writeStringToFile(output, logFile);
-
-                        *cmd.result = output;
-                        *cmd.outputFile = logFile;
-
-                        if (!cmd.nonIidParsedResults->ParseResult(output)) {
-                            uiManager.PushNotification("Warning: Could not parse test results", 5.0f, ImVec4(1,0.5,0,1));
-                        }
-
-                        cmd.testTimer->StopTestsTimer();
-
-                        uiManager.PushNotification("Non-IID test completed.", 3.0f, ImVec4(0,1,0,1));
-                        
-                    } catch (const std::exception& e) {
-                        uiManager.PushNotification(
-                            std::string("Test failed: ") + e.what(), 
-                            5.0f, 
-                            ImVec4(1,0,0,1));
-                    }
-                });
-            } else if constexpr (std::is_same_v<T, RunNonIidTestCommand>) {
-                // Enqueue work
-                GetThreadPool().Enqueue([this, cmd = command] {
-                    try {
-                        std::filesystem::path filepath = cmd.inputFile;
-                        std::string linuxPath = toWslCommandPath(filepath);
-                        std::string wslCmd = "wsl ea_non_iid -v " + linuxPath;
-
-                        cmd.testTimer->StartTestsTimer();
-
-                        std::string output = executeCommand(wslCmd);
-                        
-                        // Prepend input filename (without extension) to result filename
-                        std::string resultFilename = filepath.stem().string() + "_nonIidResult.txt";
-                        std::filesystem::path logFile = filepath.parent_path() / resultFilename;
-                        writeStringToFile(output, logFile);
-
-                        *cmd.result = output;
-                        *cmd.outputFile = logFile;
-
-                        if (!cmd.nonIidParsedResults->ParseResult(output)) {
-                            // Failed to parse
-                            uiManager.PushNotification("Warning: Could not parse test results", 5.0f, ImVec4(1,0.5,0,1));
-                        }
-
-                        cmd.testTimer->StopTestsTimer();
-
-                        uiManager.PushNotification("Non-IID test completed.", 3.0f, ImVec4(0,1,0,1));
-                    } catch (const std::exception& e) {
-                        uiManager.PushNotification(std::string("Test failed: ") + e.what(), 5.0f, ImVec4(1,0,0,1));
-                    }
-                });
-            } else if constexpr (std::is_same_v<T, RunRestartTestCommand>) {
-                // Enqueue work
-                GetThreadPool().Enqueue([this, cmd = command] {
-                    try {
-                        std::filesystem::path filepath = cmd.inputFile;
-                        std::string linuxPath = toWslCommandPath(filepath);
-                        std::string wslCmd = "wsl ea_restart -nv " + linuxPath + " " + std::to_string(cmd.minEntropy);
-
-                        cmd.testTimer->StartTestsTimer();
-
-                        std::string output = executeCommand(wslCmd);
-                        
-                        // Prepend input filename (without extension) to result filename
-                        std::string resultFilename = filepath.stem().string() + "restartResult.txt";
-                        std::filesystem::path logFile = filepath.parent_path() / resultFilename;
-                        writeStringToFile(output, logFile);
-
-                        *cmd.result = output;
-                        *cmd.outputFile = logFile;
-
-                        cmd.testTimer->StopTestsTimer();
-
-                        uiManager.PushNotification("Restart test completed.", 3.0f, ImVec4(0,1,0,1));
-                    } catch (const std::exception& e) {
-                        uiManager.PushNotification(std::string("Test failed: ") + e.what(), 5.0f, ImVec4(1,0,0,1));
-                    }
-                });
+                StartHistogramJob(command);
+            } else if constexpr (std::is_same_v<T, ConvertAndRunNonIidTestCommand> ||
+                                 std::is_same_v<T, RunNonIidTestCommand> ||
+                                 std::is_same_v<T, RunRestartTestCommand>) {
+                StartTestJob(command);
             } else if constexpr (std::is_same_v<T, FindPassingDecimationCommand>) {
-                GetThreadPool().Enqueue([this, cmd = command] {
-                    try {
-                        // Get reference to the OE
-                        auto& oe = currentProject.operationalEnvironments[cmd.oeIndex];
-
-                        // Start timer here in main thread
-                        cmd.testTimer->StartTestsTimer();
-
-                        // Run the decimation function
-                        std::string result = findFirstPassingDecimation(cmd.inputFile);
-
-                        // Write the result
-                        if (cmd.output) {
-                            *cmd.output = result;
-                        }
-
-                        oe.heuristicData.mainHistogram.firstPassingDecimationResult = result;
-                        cmd.testTimer->StopTestsTimer();
-
-                        uiManager.PushNotification("Find Passing Decimation completed.", 3.0f, ImVec4(0,1,0,1));
-                    } catch (const std::exception& e) {
-                        uiManager.PushNotification(std::string("Decimation failed: ") + e.what(), 5.0f, ImVec4(1,0,0,1));
-                    }
-                });
+                StartDecimationJob(command);
+            } else if constexpr (std::is_same_v<T, ConvertFilesCommand>) {
+                // Files are independent, so the pool converts as many at once as it has workers
+                for (size_t i = 0; i < command.job->Size(); ++i) {
+                    EnqueueJob([this, job = command.job, i] {
+                        commandExecutor.ConvertFile(*job, i);
+                    });
+                }
             }
         }, cmd);
     }
 }
 
+OperationalEnvironment* Application::FindOE(uint64_t id) {
+    for (auto& oe : currentProject.operationalEnvironments) {
+        if (oe.id == id) return &oe;
+    }
+    return nullptr;
+}
+
+void Application::PublishJobs() {
+    std::erase_if(backgroundJobs, [this](const std::shared_ptr<BackgroundJob>& job) {
+        OperationalEnvironment* oe = FindOE(job->oeId);
+        if (!oe) return true;   // deleted or a different project; the worker still owns its copy
+        if (job->done.load(std::memory_order_acquire)) {
+            job->publish(*oe);
+            return true;
+        }
+        if (job->mirror) job->mirror(*oe);
+        return false;
+    });
+}
+
+void Application::PublishNotifications() {
+    std::vector<Notification> pending;
+    {
+        std::lock_guard<std::mutex> lock(notificationMutex);
+        pending.swap(pendingNotifications);
+    }
+    for (auto& notification : pending) {
+        uiManager.PushNotification(notification.message, notification.duration, notification.color);
+    }
+}
+
+void Application::StartHistogramJob(const ProcessHistogramCommand& cmd) {
+    if (cmd.oeIndex < 0 || cmd.oeIndex >= static_cast<int>(currentProject.operationalEnvironments.size())) return;
+    const OperationalEnvironment& oe = currentProject.operationalEnvironments[cmd.oeIndex];
+
+    // The executor gets a project of just this OE; copying it shares the bins and results
+    struct HistogramRun {
+        Project project;
+        bool succeeded = false;
+    };
+    auto run = std::make_shared<HistogramRun>();
+    run->project.path = currentProject.path;
+    run->project.operationalEnvironments.push_back(oe);
+
+    auto job = std::make_shared<BackgroundJob>();
+    job->oeId = oe.id;
+    job->publish = [run](OperationalEnvironment& target) {
+        const MainHistogram& result = run->project.operationalEnvironments.front().heuristicData.mainHistogram;
+        MainHistogram& hist = target.heuristicData.mainHistogram;
+        if (!run->succeeded || hist.heuristicFilePath != result.heuristicFilePath) return;   // replaced meanwhile
+
+        // Only what processing produced; regions and smoothing may have been edited meanwhile
+        hist.convertedFilePath = result.convertedFilePath;
+        hist.minValue = result.minValue;
+        hist.maxValue = result.maxValue;
+        hist.binWidth = result.binWidth;
+        hist.binCounts = result.binCounts;
+        hist.valueIndex = result.valueIndex;
+        if (hist.smoothingKernel == result.smoothingKernel && hist.smoothingSigma == result.smoothingSigma) {
+            hist.smoothedCounts = result.smoothedCounts;
+        } else {
+            smoothHistogram(hist);
+        }
+    };
+    StartJob(job, [this, run] {
+        run->succeeded = commandExecutor.ProcessHistogram(run->project, ProcessHistogramCommand{ 0 });
+    });
+}
+
+void Application::StartDecimationJob(FindPassingDecimationCommand cmd) {
+    if (cmd.oeIndex < 0 || cmd.oeIndex >= static_cast<int>(currentProject.operationalEnvironments.size())) return;
+    OperationalEnvironment& oe = currentProject.operationalEnvironments[cmd.oeIndex];
+
+    struct DecimationRun {
+        Project project;
+        TestTimer timer;
+    };
+    auto run = std::make_shared<DecimationRun>();
+    run->project.path = currentProject.path;
+    run->project.operationalEnvironments.push_back(oe);
+    oe.heuristicData.mainHistogram.decimationTestTimer.StartTestsTimer();
+
+    auto job = std::make_shared<BackgroundJob>();
+    job->oeId = oe.id;
+    job->publish = [run](OperationalEnvironment& target) {
+        auto& hist = target.heuristicData.mainHistogram;
+        hist.firstPassingDecimationResult =
+            run->project.operationalEnvironments.front().heuristicData.mainHistogram.firstPassingDecimationResult;
+        hist.decimationTestTimer.StopTestsTimer();
+    };
+    cmd.oeIndex = 0;
+    cmd.testTimer = &run->timer;
+    StartJob(job, [this, run, cmd] {
+        commandExecutor.FindPassingDecimation(run->project, cmd);
+    });
+}
+
+void Application::StartValueIndexJobs() {
+    for (const auto& oe : currentProject.operationalEnvironments) {
+        const MainHistogram& hist = oe.heuristicData.mainHistogram;
+        if (hist.heuristicFilePath.empty() || hist.valueIndex) continue;
+
+        auto index = std::make_shared<std::shared_ptr<const ValueIndex>>();
+        auto job = std::make_shared<BackgroundJob>();
+        job->oeId = oe.id;
+        job->publish = [index, sampleFile = hist.heuristicFilePath](OperationalEnvironment& target) {
+            MainHistogram& hist = target.heuristicData.mainHistogram;
+            // Reprocessing meanwhile brings its own index; a replaced file has none of this one
+            if (*index && !hist.valueIndex && hist.heuristicFilePath == sampleFile) hist.valueIndex = *index;
+        };
+        StartJob(job, [this, index, projectPath = currentProject.path, sampleFile = hist.heuristicFilePath,
+                       binCount = hist.requestedBinCount] {
+            *index = dataManager.LoadValueIndex(projectPath, sampleFile, binCount);
+        });
+    }
+}
+
+template<typename Command>
+void Application::StartTestJob(Command cmd) {
+    auto target = LocateTest(currentProject, cmd.testTimer);
+    if (!target) return;    // its OE went away before the command was handled
+    auto [oeId, locate] = std::move(*target);
+    const std::optional<TestFields> fields = locate(*FindOE(oeId));
+
+    // The job starts from a copy of what the OE holds now and writes only to that
+    auto out = std::make_shared<TestOutputs>();
+    if (fields->sampleFile) out->sampleFile = *fields->sampleFile;
+    out->outputFile = *fields->outputFile;
+    out->result = *fields->result;
+    if (fields->parsed) out->parsed = *fields->parsed;
+    fields->timer->StartTestsTimer();
+    if (fields->progress) fields->progress->Clear();
+
+    cmd.outputFile = &out->outputFile;
+    cmd.result = &out->result;
+    cmd.testTimer = &out->timer;
+    if constexpr (requires { cmd.progress; }) {
+        cmd.nonIidParsedResults = &out->parsed;
+        cmd.progress = &out->progress;
+    }
+    if constexpr (requires { cmd.convertedFilePath; }) cmd.convertedFilePath = &out->sampleFile;
+
+    auto job = std::make_shared<BackgroundJob>();
+    job->oeId = oeId;
+    job->mirror = [out, locate, version = out->progress.Version()](OperationalEnvironment& oe) mutable {
+        if (out->progress.Version() == version) return;
+        version = out->progress.Version();
+        if (auto fields = locate(oe); fields && fields->progress) fields->progress->Publish(out->progress.Snapshot());
+    };
+    job->publish = [out, locate](OperationalEnvironment& oe) {
+        auto fields = locate(oe);
+        if (!fields) return;
+        if (fields->sampleFile) *fields->sampleFile = out->sampleFile;
+        *fields->outputFile = out->outputFile;
+        *fields->result = out->result;
+        if (fields->parsed) *fields->parsed = out->parsed;
+        if (fields->progress) fields->progress->Publish(out->progress.Snapshot());
+        fields->timer->StopTestsTimer();
+    };
+    StartJob(job, [this, cmd] {
+        if constexpr (std::is_same_v<Command, ConvertAndRunNonIidTestCommand>) {
+            commandExecutor.ConvertAndRunNonIidTest(cmd);
+        } else if constexpr (std::is_same_v<Command, RunNonIidTestCommand>) {
+            commandExecutor.RunNonIidTest(cmd);
+        } else {
+            commandExecutor.RunRestartTest(cmd);
+        }
+    });
+}
+
 void Application::Render() {
     uiManager.Render();
+
+    // Commands queued by this frame are handled by the next Update
+    if (!commandQueue.Empty()) framePacer.RequestFrame();
+    framePacer.FrameRendered();
+}
+
+bool Application::IsAnimating() const {
+    if (uiManager.IsAnimating()) return true;
+
+    for (const auto& oe : currentProject.operationalEnvironments) {
+        const auto& stat = oe.statisticData;
+        if (stat.nonIidTestTimer.testRunning || stat.restartTestTimer.testRunning) return true;
+
+        const auto& mainHist = oe.heuristicData.mainHistogram;
+        if (mainHist.testTimer.testRunning || mainHist.decimationTestTimer.testRunning) return true;
+        for (const auto& sub : mainHist.subHists) {
+            if (sub.testTimer.testRunning) return true;
+        }
+    }
+    return false;
 }
 
 void Application::Shutdown() {
     // Update last opened project in config
     if (!currentProject.name.empty()) {
-        config.lastOpenedProject.name = currentProject.name;
-        config.lastOpenedProject.path = currentProject.path;
-        config.lastOpenedProject = currentProject;
+        config.lastOpenedProject = ProjectCatalog::EntryFor(currentProject);
         dataManager.SaveProject(currentProject, config);
     }
+
+    dataManager.FlushAppConfig();
 }
 
 void Application::NewProject(const NewProjectCommand& formResult) {
@@ -270,13 +378,14 @@ bool Application::LoadProject(const std::string& filePath) {
         return false;
     }
 
-    currentProject = loadedProject;
+    currentProject = std::move(loadedProject);
+    StartValueIndexJobs();
 
     // Update last opened project in config
-    config.lastOpenedProject = currentProject;
+    config.lastOpenedProject = ProjectCatalog::EntryFor(currentProject);
 
     // Persist app.json
-    dataManager.saveAppConfig("../../data/app.json", config);
+    dataManager.saveAppConfig(config);
 
     return true;
 }
@@ -2,10 +2,17 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "../data/data_manager.h"
 #include "../ui/ui_manager.h"
 #include "app_command/app_command.h"
+#include "command_executor/command_executor.h"
+#include "frame_pacer/frame_pacer.h"
 #include "thread_pool/thread_pool.h"
 #include "types.h"
 #include "config.h"
@@ -15,16 +22,71 @@ private:
     DataManager dataManager;
     CommandQueue commandQueue;
     UIManager uiManager{commandQueue};
-    ThreadPool threadPool;
+    // Called from pool workers; the notifications are handed to the UI in Update
+    CommandExecutor commandExecutor{dataManager, [this](const std::string& msg, float duration, ImVec4 color) {
+        {
+            std::lock_guard<std::mutex> lock(notificationMutex);
+            pendingNotifications.push_back({ msg, duration, color });
+        }
+        framePacer.RequestFrame();
+    }};
+    FramePacer framePacer;
+    std::mutex notificationMutex;
+    std::vector<Notification> pendingNotifications;    // guarded by notificationMutex
+
+    // A pipeline command running on the pool. The worker only touches the job's
+    // own copy of the OE inputs and outputs; the project is updated from it on
+    // the UI thread, in Update. The OE is looked up by id each time, so a job
+    // that outlives its OE (deleted, project closed) publishes nowhere.
+    struct BackgroundJob {
+        uint64_t oeId = 0;
+        std::function<void(OperationalEnvironment&)> mirror;    // each Update while running, e.g. live progress
+        std::function<void(OperationalEnvironment&)> publish;   // once, after the worker is done
+        std::atomic<bool> done{ false };
+    };
 
     Config::AppConfig config;
     Project currentProject;
     std::vector<std::string> vendors;
+    std::vector<std::shared_ptr<BackgroundJob>> backgroundJobs;   // UI thread only
+    ThreadPool threadPool; // declared last so workers are joined before anything they touch is destroyed
     
     void SetupImGuiStyle();
     void LoadFonts();
     ThreadPool& GetThreadPool() { return threadPool; }
 
+    // Runs a job on the pool and asks for a frame when it is done, so the result shows up
+    template<typename F>
+    void EnqueueJob(F&& job) {
+        GetThreadPool().Enqueue([this, job = std::forward<F>(job)]() mutable {
+            job();
+            framePacer.RequestFrame();
+        });
+    }
+
+    // Runs work on the pool for job, which Update then publishes
+    template<typename F>
+    void StartJob(std::shared_ptr<BackgroundJob> job, F&& work) {
+        backgroundJobs.push_back(job);
+        EnqueueJob([job, work = std::forward<F>(work)]() mutable {
+            work();
+            job->done.store(true, std::memory_order_release);
+        });
+    }
+
+    void StartHistogramJob(const ProcessHistogramCommand& cmd);
+    void StartDecimationJob(FindPassingDecimationCommand cmd);
+    // Loads each processed OE's value index from the histogram cache, after the project has opened
+    void StartValueIndexJobs();
+    template<typename Command>
+    void StartTestJob(Command cmd);
+    void PublishJobs();
+    void PublishNotifications();
+    OperationalEnvironment* FindOE(uint64_t id);
+
+    // Something on screen changes without input: a test spinner, a notification countdown
+    bool IsAnimating() const;
+
 public:
     Application() 
         : threadPool([]{
@@ -40,6 +102,15 @@ public:
     void Update();
     void Render();
     void Shutdown();
+
+    // Frame pacing: the platform loop waits up to FrameWaitTimeout() for events and
+    // renders only when FrameDue(). Input and wake-ups go through RequestFrame().
+    bool FrameDue() { return framePacer.FrameDue(IsAnimating()); }
+    std::chrono::milliseconds FrameWaitTimeout() const { return framePacer.WaitTimeout(IsAnimating()); }
+    void RequestFrame() { framePacer.RequestFrame(); }
+    // A due frame that was not rendered (minimized window); paces like a rendered one
+    void FrameSkipped() { framePacer.FrameRendered(); }
+    void SetWakeCallback(std::function<void()> wake) { framePacer.SetWakeCallback(std::move(wake)); }
     
     // Project management
     void NewProject(const NewProjectCommand& formResult);
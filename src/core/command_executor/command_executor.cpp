@@ -0,0 +1,365 @@
+
+#include "command_executor.h"
+#include "../../data/find_first_passing_decimation/find_first_passing_decimation.h"
+#include "../../data/histogram_cache/histogram_cache.h"
+#include "../../file_utils/file_utils.h"
+#include "../trace/trace.h"
+
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+void CommandExecutor::Notify(const std::string& message, float duration, ImVec4 color) const {
+    if (m_notify) m_notify(message, duration, color);
+}
+
+void CommandExecutor::ReportToolRun(const std::string& tool, const ProcessResult& result) const {
+    if (m_onToolRun) m_onToolRun(tool, result);
+}
+
+void CommandExecutor::KeepPartialLog(const ProcessError& error, const std::filesystem::path& logFile,
+                                     SharedText* result, std::filesystem::path* outputFile) const {
+    std::string log = error.PartialLog();
+    try {
+        writeStringToFile(log, logFile);
+        *outputFile = logFile;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+    }
+    *result = std::move(log);
+}
+
+std::string CommandExecutor::ToolLog(ProcessResult& run) {
+    std::string log = std::move(run.output);
+    if (!run.Succeeded()) {
+        if (!log.empty() && log.back() != '\n') log += '\n';
+        log += run.StatusLine();
+    }
+    return log;
+}
+
+ProcessResult CommandExecutor::RunNonIidTool(const std::filesystem::path& samples, NonIidProgress* progress, NonIidReport& report) {
+    const ToolConfig tools = ToolConfig::Current();
+    const auto argv = tools.Command(tools.nonIid, { "-v", tools.ToolPath(samples) }, true);
+
+    // Estimators report one at a time over a long run; publish each as it lands
+    NonIidStreamParser parser;
+    ProcessOptions options;
+    options.limits = tools.nonIidLimits;
+    options.onOutput = [&](std::string_view chunk) {
+        if (parser.Feed(chunk) && progress) progress->Publish(parser.Report());
+    };
+    if (progress) progress->Clear();
+
+    ProcessResult run;
+    try {
+        TRACE_SCOPE("tool.ea_non_iid");
+        run = executeCommand(argv, options);
+    } catch (const ProcessError& e) {
+        ReportToolRun("ea_non_iid", e.Result());
+        throw;
+    }
+    ReportToolRun("ea_non_iid", run);
+    if (parser.Finish() && progress) progress->Publish(parser.Report());
+    report = parser.TakeReport();
+    return run;
+}
+
+bool CommandExecutor::ProcessHistogram(Project& project, const ProcessHistogramCommand& cmd) {
+    try {
+        auto& oe = project.operationalEnvironments[cmd.oeIndex];
+        Trace::ContextScope traceContext(oe.oeName);
+
+        // 1. Convert decimal file first, unless the .bin from the last run still matches it
+        auto& mainHist = oe.heuristicData.mainHistogram;
+        if (!mainHist.heuristicFilePath.empty()) {
+            // Same file identity the histogram cache keys on; unsaved projects have no cache
+            std::optional<HistogramCacheKey> source;
+            if (!project.path.empty()) source = HistogramCache::KeyFor(mainHist.heuristicFilePath, 0);
+            const bool current = source && !mainHist.convertedFilePath.empty() &&
+                                 HistogramCache(project.path).ConversionCurrent(*source, mainHist.convertedFilePath);
+            if (!current) {
+                if (!m_dataManager.ConvertDecimalFile(mainHist.heuristicFilePath, mainHist.convertedFilePath)) {
+                    Notify("Failed to convert file for statistical tests.", 5.0f, ImVec4(1,0,0,1));
+                    return false;
+                }
+                if (source) HistogramCache(project.path).RecordConversion(*source, mainHist.convertedFilePath);
+            }
+        } else {
+            Notify("No raw file uploaded to convert.", 5.0f, ImVec4(1,0,0,1));
+            return false;
+        }
+
+        // 2. Process histogram
+        m_dataManager.processHistogramForProject(project, cmd.oeIndex, m_notify);
+
+        Notify("Histogram processing completed.", 3.0f, ImVec4(0,1,0,1));
+        return true;
+    } catch (const std::exception& e) {
+        Notify(std::string("Histogram processing failed: ") + e.what(), 5.0f, ImVec4(1,0,0,1));
+        return false;
+    }
+}
+
+bool CommandExecutor::ConvertAndRunNonIidTest(const ConvertAndRunNonIidTestCommand& cmd) {
+    Trace::ContextScope traceContext(cmd.subHistIndex);
+    std::filesystem::path logFile;
+    try {
+        // Step 1: Convert
+        Notify("Converting sub-histogram...", 3.0f, ImVec4(0,0.5,1,1));
+        
+        if (!m_dataManager.ConvertDecimalFile(
+                cmd.inputFile,
+                *cmd.convertedFilePath,
+                cmd.minValue,
+                cmd.maxValue,
+                cmd.subHistIndex)) 
+        {
+            Notify("Failed to convert file.", 5.0f, ImVec4(1,0,0,1));
+            return false;
+        }
+        
+        // Step 2: Run test
+        Notify("Running Non-IID test...", 3.0f, ImVec4(0,0.5,1,1));
+        
+        cmd.testTimer->StartTestsTimer();
+
+        std::string resultFilename = cmd.convertedFilePath->stem().string() + "_nonIidResult.txt";
+        logFile = cmd.convertedFilePath->parent_path() / resultFilename;
+
+        NonIidReport report;
+        ProcessResult run = RunNonIidTool(*cmd.convertedFilePath, cmd.progress, report);
+        std::string output = ToolLog(run);
+        writeStringToFile(output, logFile);
+
+        *cmd.result = std::move(output);
+        *cmd.outputFile = logFile;
+
+        if (!run.Succeeded()) {
+            cmd.testTimer->StopTestsTimer();
+            Notify("Test failed: ea_non_iid " + run.Summary(), 5.0f, ImVec4(1,0,0,1));
+            return false;
+        }
+
+        const bool parsed = cmd.nonIidParsedResults->Assign(report);
+        if (!parsed) {
+            Notify("Warning: Could not parse test results", 5.0f, ImVec4(1,0.5,0,1));
+        }
+
+        cmd.testTimer->StopTestsTimer();
+
+        Notify("Non-IID test completed.", 3.0f, ImVec4(0,1,0,1));
+        return parsed;
+    } catch (const ProcessError& e) {
+        cmd.testTimer->StopTestsTimer();
+        KeepPartialLog(e, logFile, cmd.result, cmd.outputFile);
+        Notify(std::string("Test failed: ") + e.what(), 5.0f, ImVec4(1,0,0,1));
+        return false;
+    } catch (const std::exception& e) {
+        cmd.testTimer->StopTestsTimer();
+        Notify(std::string("Test failed: ") + e.what(), 5.0f, ImVec4(1,0,0,1));
+        return false;
+    }
+}
+
+bool CommandExecutor::RunNonIidTest(const RunNonIidTestCommand& cmd) {
+    std::filesystem::path logFile;
+    try {
+        std::filesystem::path filepath = cmd.inputFile;
+
+        // Prepend input filename (without extension) to result filename
+        std::string resultFilename = filepath.stem().string() + "_nonIidResult.txt";
+        logFile = filepath.parent_path() / resultFilename;
+
+        cmd.testTimer->StartTestsTimer();
+
+        NonIidReport report;
+        ProcessResult run = RunNonIidTool(filepath, cmd.progress, report);
+        std::string output = ToolLog(run);
+        writeStringToFile(output, logFile);
+
+        *cmd.result = std::move(output);
+        *cmd.outputFile = logFile;
+
+        if (!run.Succeeded()) {
+            cmd.testTimer->StopTestsTimer();
+            Notify("Test failed: ea_non_iid " + run.Summary(), 5.0f, ImVec4(1,0,0,1));
+            return false;
+        }
+
+        const bool parsed = cmd.nonIidParsedResults->Assign(report);
+        if (!parsed) {
+            // Failed to parse
+            Notify("Warning: Could not parse test results", 5.0f, ImVec4(1,0.5,0,1));
+        }
+
+        cmd.testTimer->StopTestsTimer();
+
+        Notify("Non-IID test completed.", 3.0f, ImVec4(0,1,0,1));
+        return parsed;
+    } catch (const ProcessError& e) {
+        cmd.testTimer->StopTestsTimer();
+        KeepPartialLog(e, logFile, cmd.result, cmd.outputFile);
+        Notify(std::string("Test failed: ") + e.what(), 5.0f, ImVec4(1,0,0,1));
+        return false;
+    } catch (const std::exception& e) {
+        cmd.testTimer->StopTestsTimer();
+        Notify(std::string("Test failed: ") + e.what(), 5.0f, ImVec4(1,0,0,1));
+        return false;
+    }
+}
+
+bool CommandExecutor::RunRestartTest(const RunRestartTestCommand& cmd) {
+    std::filesystem::path logFile;
+    try {
+        std::filesystem::path filepath = cmd.inputFile;
+        const ToolConfig tools = ToolConfig::Current();
+        // An idle limit needs the tool to flush each line as it goes
+        const bool lineBuffered = tools.restartLimits.idleSeconds > 0.0;
+        const auto argv = tools.Command(tools.restart, { "-nv", tools.ToolPath(filepath), std::to_string(cmd.minEntropy) }, lineBuffered);
+        ProcessOptions options;
+        options.limits = tools.restartLimits;
+
+        // Prepend input filename (without extension) to result filename
+        std::string resultFilename = filepath.stem().string() + "restartResult.txt";
+        logFile = filepath.parent_path() / resultFilename;
+
+        cmd.testTimer->StartTestsTimer();
+
+        ProcessResult run;
+        try {
+            TRACE_SCOPE("tool.ea_restart");
+            run = executeCommand(argv, options);
+        } catch (const ProcessError& e) {
+            ReportToolRun("ea_restart", e.Result());
+            throw;
+        }
+        ReportToolRun("ea_restart", run);
+        std::string output = ToolLog(run);
+        writeStringToFile(output, logFile);
+
+        *cmd.result = std::move(output);
+        *cmd.outputFile = logFile;
+
+        cmd.testTimer->StopTestsTimer();
+
+        if (!run.Succeeded()) {
+            Notify("Test failed: ea_restart " + run.Summary(), 5.0f, ImVec4(1,0,0,1));
+            return false;
+        }
+        // A run that reports no sanity check, or passes it without a
+        // validation, did not get as far as a result
+        const RestartReport report = ParseRestart(cmd.result->str());
+        if (!report.sanityPassed || (*report.sanityPassed && !report.validationPassed)) {
+            Notify("Test failed: could not parse restart results.", 5.0f, ImVec4(1,0,0,1));
+            return false;
+        }
+
+        // A failed check is a result, not an error
+        if (report.sanityPassed == false) {
+            Notify("Restart test completed: sanity check failed.", 5.0f, ImVec4(1,0.5,0,1));
+        } else if (report.validationPassed == false) {
+            Notify("Restart test completed: validation failed.", 5.0f, ImVec4(1,0.5,0,1));
+        } else {
+            Notify("Restart test completed.", 3.0f, ImVec4(0,1,0,1));
+        }
+        return true;
+    } catch (const ProcessError& e) {
+        cmd.testTimer->StopTestsTimer();
+        KeepPartialLog(e, logFile, cmd.result, cmd.outputFile);
+        Notify(std::string("Test failed: ") + e.what(), 5.0f, ImVec4(1,0,0,1));
+        return false;
+    } catch (const std::exception& e) {
+        cmd.testTimer->StopTestsTimer();
+        Notify(std::string("Test failed: ") + e.what(), 5.0f, ImVec4(1,0,0,1));
+        return false;
+    }
+}
+
+bool CommandExecutor::FindPassingDecimation(Project& project, const FindPassingDecimationCommand& cmd) {
+    try {
+        // Get reference to the OE
+        auto& oe = project.operationalEnvironments[cmd.oeIndex];
+        Trace::ContextScope traceContext(oe.oeName);
+
+        cmd.testTimer->StartTestsTimer();
+
+        // Run the decimation function
+        DecimationReport result;
+        ProcessResult run;
+        try {
+            TRACE_SCOPE("tool.find_first_passing_decimation");
+            result = findFirstPassingDecimation(cmd.inputFile, &run);
+        } catch (const ProcessError& e) {
+            ReportToolRun("find-first-passing-decimation.pl", e.Result());
+            throw;
+        }
+        ReportToolRun("find-first-passing-decimation.pl", run);
+
+        // A failed run has no outcome of its own; store why instead
+        const bool succeeded = run.Succeeded() && result.Outcome() != DecimationOutcome::Unknown;
+        const std::string summary = run.Succeeded() ? result.Summary() : "Error: decimation run " + run.Summary();
+
+        // Write the result
+        if (cmd.output) {
+            *cmd.output = summary;
+        }
+
+        oe.heuristicData.mainHistogram.firstPassingDecimationResult = summary;
+        cmd.testTimer->StopTestsTimer();
+
+        if (!succeeded) {
+            Notify("Decimation failed: " + summary, 5.0f, ImVec4(1,0,0,1));
+            return false;
+        }
+        Notify("Find Passing Decimation completed.", 3.0f, ImVec4(0,1,0,1));
+        return true;
+    } catch (const ProcessError& e) {
+        cmd.testTimer->StopTestsTimer();
+        // Stored in place of the script's outcome so the project says why there is none
+        const std::string stopped = "Error: decimation run " + (e.Result().started ? e.Result().Summary() : "could not start");
+        project.operationalEnvironments[cmd.oeIndex].heuristicData.mainHistogram.firstPassingDecimationResult = stopped;
+        if (cmd.output) *cmd.output = stopped;
+        Notify(std::string("Decimation failed: ") + e.what(), 5.0f, ImVec4(1,0,0,1));
+        return false;
+    } catch (const std::exception& e) {
+        cmd.testTimer->StopTestsTimer();
+        Notify(std::string("Decimation failed: ") + e.what(), 5.0f, ImVec4(1,0,0,1));
+        return false;
+    }
+}
+
+bool CommandExecutor::ConvertFile(ConversionJob& job, size_t index) {
+    FileConversion& file = job.File(index);
+    if (file.state.load(std::memory_order_acquire) != ConversionState::Queued) return false;  // failed up front
+
+    ConversionState state = ConversionState::Cancelled;
+    if (!job.Cancelled()) {
+        file.state.store(ConversionState::Running, std::memory_order_release);
+        try {
+            std::filesystem::path output;
+            if (m_dataManager.ConvertDecimalFile(file.input, output, std::nullopt, std::nullopt, 0, &file.progress)) {
+                file.output = output;
+                state = ConversionState::Done;
+            } else if (!job.Cancelled()) {
+                file.error = std::filesystem::exists(file.input) ? "No samples found or output not writable" : "File not found";
+                state = ConversionState::Failed;
+            }
+        } catch (const std::exception& e) {
+            file.error = e.what();
+            state = ConversionState::Failed;
+        }
+    }
+
+    if (job.Finish(index, state)) {
+        const size_t failed = job.FailedCount();
+        if (job.Cancelled()) {
+            Notify("File conversion cancelled.", 3.0f, ImVec4(1,0.5,0,1));
+        } else if (failed > 0) {
+            Notify("Converted " + std::to_string(job.Size() - failed) + " of " + std::to_string(job.Size()) + " files.", 5.0f, ImVec4(1,0.5,0,1));
+        } else {
+            Notify("Converted " + std::to_string(job.Size()) + " files.", 3.0f, ImVec4(0,1,0,1));
+        }
+    }
+    return state == ConversionState::Done;
+}
@@ -0,0 +1,47 @@
+
+#pragma once
+
+#include "../app_command/app_command.h"
+#include "../types.h"
+#include "../../data/data_manager.h"
+
+// Runs the long-running pipeline commands on the calling thread.
+//
+// The GUI enqueues these onto its ThreadPool from Application::Update; the
+// headless batch runner calls them directly from its own workers. Progress and
+// failures are reported through the notify callback, and each call returns
+// whether its stage succeeded; a tool that exits non-zero fails its stage.
+// Every external tool run is also passed to the tool-run callback, if set,
+// with its exit status and the resources it used.
+using ToolRunCallback = std::function<void(const std::string& tool, const ProcessResult& result)>;
+
+class CommandExecutor {
+private:
+    DataManager& m_dataManager;
+    NotificationCallback m_notify;
+    ToolRunCallback m_onToolRun;
+
+    void Notify(const std::string& message, float duration, ImVec4 color) const;
+    void ReportToolRun(const std::string& tool, const ProcessResult& result) const;
+    // A tool stopped by its limits: its partial output and the reason go to
+    // logFile and the result shown in the UI
+    void KeepPartialLog(const ProcessError& error, const std::filesystem::path& logFile,
+                        SharedText* result, std::filesystem::path* outputFile) const;
+    // A tool's output for its result file, ending with the exit status if it failed
+    static std::string ToolLog(ProcessResult& run);
+    // Runs ea_non_iid on samples, parsing its output into progress as it arrives
+    ProcessResult RunNonIidTool(const std::filesystem::path& samples, NonIidProgress* progress, NonIidReport& report);
+
+public:
+    CommandExecutor(DataManager& dataManager, NotificationCallback notify)
+        : m_dataManager(dataManager), m_notify(std::move(notify)) {}
+
+    void SetToolRunCallback(ToolRunCallback cb) { m_onToolRun = std::move(cb); }
+
+    bool ProcessHistogram(Project& project, const ProcessHistogramCommand& cmd);
+    bool ConvertAndRunNonIidTest(const ConvertAndRunNonIidTestCommand& cmd);
+    bool RunNonIidTest(const RunNonIidTestCommand& cmd);
+    bool RunRestartTest(const RunRestartTestCommand& cmd);
+    bool FindPassingDecimation(Project& project, const FindPassingDecimationCommand& cmd);
+    bool ConvertFile(ConversionJob& job, size_t index);
+};
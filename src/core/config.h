@@ -2,6 +2,8 @@
 #pragma once
 
 #include "types.h"
+#include "tool_config/tool_config.h"
+#include "../data/project_catalog/project_catalog.h"
 
 #include "imgui.h"
 
@@ -21,7 +23,11 @@ namespace Config {
     // Application info
     constexpr const char* APPLICATION_TITLE = "Entropy Analysis Tool";
     constexpr const char* APPLICATION_VERSION = "2.0.0";
-    
+
+    // Data files
+    constexpr const char* APP_CONFIG_FILE = "../../data/app.json";
+    constexpr const char* VENDOR_LIST_FILE = "../../data/vendorList.json";
+
     // Window settings
     constexpr int DEFAULT_WINDOW_WIDTH = 1280;
     constexpr int DEFAULT_WINDOW_HEIGHT = 800;
@@ -35,6 +41,9 @@ namespace Config {
     constexpr float MENU_BAR_HEIGHT = 25.0f;
     constexpr float HEADER_HEIGHT = 60.0f;
     constexpr float DASHBOARD_HEIGHT = 120.0f;
+
+    // Assessment settings
+    constexpr long long MIN_REGION_SAMPLES = 1'000'000;     // SP 800-90B minimum for a non-IID run
     
     // Dark theme colors
     const ImVec4 BACKGROUND_COLOR = {0.15f, 0.15f, 0.15f, 1.00f};     // Dark grey background
@@ -125,8 +134,10 @@ namespace Config {
     struct AppConfig {
         const char* APPLICATION_TITLE = "Entropy Analysis Tool";
         const char* APPLICATION_VERSION = "0.1.0";
-        Project lastOpenedProject;
-        std::vector<Project> savedProjects;
+        ProjectCatalogEntry lastOpenedProject;     // identity only; the project itself lives in Application
+        ProjectCatalog savedProjects;
         std::vector<std::string> vendorsList;
+        ToolConfig tools;                          // read from app.json, which keeps it on write
+        unsigned int toolJobs = 0;                 // "toolJobs": external tools running at once, 0 = default
     };
 }
\ No newline at end of file
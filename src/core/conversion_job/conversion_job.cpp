@@ -0,0 +1,70 @@
+
+#include "conversion_job.h"
+
+#include <algorithm>
+#include <map>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+ConversionJob::ConversionJob(const std::vector<fs::path>& inputs)
+    : m_start(Clock::now())
+{
+    std::map<fs::path, fs::path> outputs;     // output -> input that claimed it
+    for (const auto& input : inputs) {
+        std::error_code ec;
+        const fs::path normalized = fs::weakly_canonical(input, ec).lexically_normal();
+        const fs::path key = ec ? input.lexically_normal() : normalized;
+        if (std::any_of(m_files.begin(), m_files.end(), [&](const auto& f) { return f->input == key; })) continue;
+
+        auto file = std::make_unique<FileConversion>();
+        file->input = key;
+        file->progress.cancel = &m_cancel;
+        const auto size = fs::file_size(key, ec);
+        file->totalBytes = ec ? 0 : static_cast<uint64_t>(size);
+
+        auto [it, inserted] = outputs.emplace(OutputPathFor(key), key);
+        if (!inserted) file->error = "Writes the same output as " + it->second.filename().string();
+        m_files.push_back(std::move(file));
+    }
+
+    for (size_t i = 0; i < m_files.size(); ++i) {
+        if (!m_files[i]->error.empty()) Finish(i, ConversionState::Failed);
+    }
+}
+
+bool ConversionJob::Finish(size_t index, ConversionState state) {
+    m_files[index]->state.store(state, std::memory_order_release);
+    if (state == ConversionState::Failed) m_failed.fetch_add(1, std::memory_order_acq_rel);
+
+    const bool last = m_finished.fetch_add(1, std::memory_order_acq_rel) + 1 == m_files.size();
+    if (last) m_end.store(Clock::now().time_since_epoch().count(), std::memory_order_release);
+    return last;
+}
+
+uint64_t ConversionJob::BytesRead() const {
+    uint64_t total = 0;
+    for (const auto& file : m_files) total += file->progress.bytesRead.load(std::memory_order_relaxed);
+    return total;
+}
+
+uint64_t ConversionJob::TotalBytes() const {
+    uint64_t total = 0;
+    for (const auto& file : m_files) total += file->totalBytes;
+    return total;
+}
+
+double ConversionJob::ElapsedSeconds() const {
+    const Clock::rep end = m_end.load(std::memory_order_acquire);
+    const Clock::time_point stop = end ? Clock::time_point(Clock::duration(end)) : Clock::now();
+    return std::chrono::duration<double>(stop - m_start).count();
+}
+
+double ConversionJob::BytesPerSecond() const {
+    const double seconds = ElapsedSeconds();
+    return seconds > 0.0 ? BytesRead() / seconds : 0.0;
+}
+
+fs::path ConversionJob::OutputPathFor(const fs::path& input) {
+    return input.parent_path() / (input.stem().string() + ".bin");
+}
@@ -0,0 +1,80 @@
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Progress and cancellation for one ConvertDecimalFile call. The converting
+// thread advances bytesRead and stops early once *cancel is set.
+struct ConvertProgress {
+    std::atomic<uint64_t> bytesRead{ 0 };
+    const std::atomic<bool>* cancel = nullptr;
+
+    bool Cancelled() const { return cancel && cancel->load(std::memory_order_relaxed); }
+};
+
+enum class ConversionState {
+    Queued,
+    Running,
+    Done,
+    Failed,
+    Cancelled
+};
+
+struct FileConversion {
+    std::filesystem::path input;
+    std::filesystem::path output;   // valid once Done
+    std::string error;              // valid once Failed
+    uint64_t totalBytes = 0;
+    ConvertProgress progress;
+
+    // output/error are written before the final state is stored
+    std::atomic<ConversionState> state{ ConversionState::Queued };
+};
+
+// A batch of decimal -> .bin conversions shared between the UI and the pool
+// workers converting it; each file is converted by its own pool job.
+class ConversionJob {
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    std::vector<std::unique_ptr<FileConversion>> m_files;
+    std::atomic<bool> m_cancel{ false };
+    std::atomic<size_t> m_finished{ 0 };
+    std::atomic<size_t> m_failed{ 0 };
+    Clock::time_point m_start;
+    std::atomic<Clock::rep> m_end{ 0 };     // set by the last file to finish
+
+public:
+    // Duplicate inputs are dropped. Inputs that would write the same .bin as an
+    // earlier one fail up front, since parallel conversions would clobber it.
+    explicit ConversionJob(const std::vector<std::filesystem::path>& inputs);
+
+    size_t Size() const { return m_files.size(); }
+    FileConversion& File(size_t index) { return *m_files[index]; }
+    const FileConversion& File(size_t index) const { return *m_files[index]; }
+
+    void Cancel() { m_cancel.store(true, std::memory_order_relaxed); }
+    bool Cancelled() const { return m_cancel.load(std::memory_order_relaxed); }
+
+    // Stores the final state of a file; true for the call that finished the job
+    bool Finish(size_t index, ConversionState state);
+
+    bool Finished() const { return m_finished.load(std::memory_order_acquire) == m_files.size(); }
+    size_t FinishedCount() const { return m_finished.load(std::memory_order_acquire); }
+    size_t FailedCount() const { return m_failed.load(std::memory_order_acquire); }
+
+    uint64_t BytesRead() const;
+    uint64_t TotalBytes() const;
+    double ElapsedSeconds() const;
+    double BytesPerSecond() const;
+
+    // Where ConvertDecimalFile writes the symbols of a whole file
+    static std::filesystem::path OutputPathFor(const std::filesystem::path& input);
+};
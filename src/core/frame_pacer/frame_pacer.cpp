@@ -0,0 +1,35 @@
+
+#include "frame_pacer.h"
+
+#include <algorithm>
+
+void FramePacer::RequestFrame() {
+    // Only the first request since the last frame needs to wake the loop, and
+    // only when it comes from another thread: the loop itself is not waiting
+    if (!m_requested.exchange(true, std::memory_order_acq_rel) && m_wake
+        && std::this_thread::get_id() != m_loopThread) {
+        m_wake();
+    }
+}
+
+bool FramePacer::FrameDue(bool animating, Clock::time_point now) {
+    if (m_requested.exchange(false, std::memory_order_acq_rel)) {
+        m_settleFrames = SETTLE_FRAMES;
+        return true;
+    }
+    if (m_settleFrames > 0) return true;
+    return WaitTimeout(animating, now).count() == 0;
+}
+
+void FramePacer::FrameRendered(Clock::time_point now) {
+    m_lastFrame = now;
+    if (m_settleFrames > 0) --m_settleFrames;
+}
+
+std::chrono::milliseconds FramePacer::WaitTimeout(bool animating, Clock::time_point now) const {
+    if (m_settleFrames > 0 || m_requested.load(std::memory_order_acquire)) return std::chrono::milliseconds(0);
+
+    const auto interval = animating ? ANIMATION_INTERVAL : IDLE_INTERVAL;
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_lastFrame);
+    return std::max(std::chrono::milliseconds(0), interval - elapsed);
+}
@@ -0,0 +1,46 @@
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+// Decides when the main loop has to render. A frame is due when something asked
+// for one (input, a finished job, a queued command), for a few frames after that
+// so ImGui can settle hover and layout, at a steady rate while something animates
+// (spinners, countdowns), and otherwise only at a slow idle tick. In between, the
+// platform loop sleeps on its event queue for WaitTimeout().
+//
+// RequestFrame may be called from any thread; the rest belongs to the loop thread.
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int SETTLE_FRAMES = 3;
+    static constexpr std::chrono::milliseconds ANIMATION_INTERVAL{ 50 };
+    static constexpr std::chrono::milliseconds IDLE_INTERVAL{ 500 };
+
+private:
+    std::atomic<bool> m_requested{ true };      // the first frame is always due
+    int m_settleFrames = 0;
+    Clock::time_point m_lastFrame{};
+    std::function<void()> m_wake;
+    std::thread::id m_loopThread;
+
+public:
+    // Called after a request from another thread, to interrupt the loop's wait;
+    // set it from the loop thread, whose own requests never need a wake-up
+    void SetWakeCallback(std::function<void()> wake) {
+        m_wake = std::move(wake);
+        m_loopThread = std::this_thread::get_id();
+    }
+
+    void RequestFrame();
+
+    bool FrameDue(bool animating, Clock::time_point now = Clock::now());
+    void FrameRendered(Clock::time_point now = Clock::now());
+
+    // How long the loop may wait for events before the next frame is due (0 = now)
+    std::chrono::milliseconds WaitTimeout(bool animating, Clock::time_point now = Clock::now()) const;
+};
@@ -0,0 +1,561 @@
+
+#include "process_executor.h"
+#include "../trace/trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/resource.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+#endif
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr size_t READ_CHUNK = 64 << 10;
+
+    // Between asking a stopped tool to exit and killing it outright
+    constexpr auto STOP_GRACE = std::chrono::seconds(2);
+
+    double SecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    Clock::duration Seconds(double seconds) {
+        return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+    }
+
+    // Wall-clock and output-idle deadlines of one run. Output() may be called
+    // from the reading thread while another thread checks.
+    class Watchdog {
+    private:
+        const ProcessLimits& m_limits;
+        Clock::time_point m_launched;
+        std::atomic<Clock::rep> m_lastOutput;
+
+    public:
+        Watchdog(const ProcessLimits& limits, Clock::time_point launched)
+            : m_limits(limits), m_launched(launched), m_lastOutput(launched.time_since_epoch().count())
+        {}
+
+        void Output() { m_lastOutput.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed); }
+
+        // The limit exceeded at now, or Exited while within all of them
+        ProcessStop Check(Clock::time_point now) const {
+            if (m_limits.wallSeconds > 0.0 && now >= m_launched + Seconds(m_limits.wallSeconds)) return ProcessStop::WallLimit;
+            if (m_limits.idleSeconds > 0.0 && now >= LastOutput() + Seconds(m_limits.idleSeconds)) return ProcessStop::Stalled;
+            return ProcessStop::Exited;
+        }
+
+        Clock::time_point NextDeadline() const {
+            Clock::time_point next = Clock::time_point::max();
+            if (m_limits.wallSeconds > 0.0) next = std::min(next, m_launched + Seconds(m_limits.wallSeconds));
+            if (m_limits.idleSeconds > 0.0) next = std::min(next, LastOutput() + Seconds(m_limits.idleSeconds));
+            return next;
+        }
+
+        Clock::time_point LastOutput() const {
+            return Clock::time_point(Clock::duration(m_lastOutput.load(std::memory_order_relaxed)));
+        }
+    };
+
+    // Milliseconds from now until deadline, for poll / WaitForSingleObject
+    long long MillisecondsUntil(Clock::time_point deadline) {
+        if (deadline == Clock::time_point::max()) return -1;
+        const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - Clock::now()).count();
+        return std::clamp<long long>(remaining, 0, 1 << 30);
+    }
+
+#ifdef _WIN32
+    double FileTimeSeconds(const FILETIME& time) {
+        ULARGE_INTEGER value;
+        value.LowPart = time.dwLowDateTime;
+        value.HighPart = time.dwHighDateTime;
+        return value.QuadPart / 1e7;     // 100 ns ticks
+    }
+
+    std::string LastErrorMessage(const char* what) {
+        return std::string(what) + " failed (error " + std::to_string(GetLastError()) + ")";
+    }
+
+    // Quotes one argument so the child's CRT splits it back out unchanged
+    std::string QuoteArgument(const std::string& arg) {
+        if (!arg.empty() && arg.find_first_of(" \t\n\v\"") == std::string::npos) return arg;
+
+        std::string quoted = "\"";
+        for (auto it = arg.begin(); ; ++it) {
+            size_t backslashes = 0;
+            while (it != arg.end() && *it == '\\') { ++it; ++backslashes; }
+            if (it == arg.end()) {
+                quoted.append(backslashes * 2, '\\');     // they precede the closing quote
+                break;
+            }
+            if (*it == '"') {
+                quoted.append(backslashes * 2 + 1, '\\');
+            } else {
+                quoted.append(backslashes, '\\');
+            }
+            quoted.push_back(*it);
+        }
+        quoted.push_back('"');
+        return quoted;
+    }
+
+    void RunChild(const std::vector<std::string>& argv, const ProcessOptions& options, ProcessResult& result) {
+        SECURITY_ATTRIBUTES inherit{ sizeof(SECURITY_ATTRIBUTES), nullptr, TRUE };
+        HANDLE readPipe = nullptr;
+        HANDLE writePipe = nullptr;
+        if (!CreatePipe(&readPipe, &writePipe, &inherit, 0)) {
+            result.error = LastErrorMessage("CreatePipe");
+            return;
+        }
+        SetHandleInformation(readPipe, HANDLE_FLAG_INHERIT, 0);
+        HANDLE nul = CreateFileA("NUL", GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                 &inherit, OPEN_EXISTING, 0, nullptr);
+
+        // Hand the child only its own handles; with several tools starting at
+        // once, a sibling's inherited pipe end would hold our pipe open past exit
+        HANDLE inherited[2] = { writePipe, nul };
+        SIZE_T attributeSize = 0;
+        InitializeProcThreadAttributeList(nullptr, 1, 0, &attributeSize);
+        std::string attributeBuffer(attributeSize, '\0');
+        auto attributes = reinterpret_cast<LPPROC_THREAD_ATTRIBUTE_LIST>(attributeBuffer.data());
+        InitializeProcThreadAttributeList(attributes, 1, 0, &attributeSize);
+        UpdateProcThreadAttribute(attributes, 0, PROC_THREAD_ATTRIBUTE_HANDLE_LIST, inherited,
+                                  nul != INVALID_HANDLE_VALUE ? sizeof(inherited) : sizeof(HANDLE), nullptr, nullptr);
+
+        STARTUPINFOEXA startup{};
+        startup.StartupInfo.cb = sizeof(startup);
+        startup.StartupInfo.dwFlags = STARTF_USESTDHANDLES;
+        startup.StartupInfo.hStdOutput = writePipe;
+        startup.StartupInfo.hStdInput = nul != INVALID_HANDLE_VALUE ? nul : nullptr;
+        startup.StartupInfo.hStdError = options.mergeStderr ? writePipe : (nul != INVALID_HANDLE_VALUE ? nul : nullptr);
+        startup.lpAttributeList = attributes;
+
+        std::string commandLine;
+        for (const auto& arg : argv) {
+            if (!commandLine.empty()) commandLine += ' ';
+            commandLine += QuoteArgument(arg);
+        }
+
+        // The job holds the whole tree: the watchdog terminates it as a unit,
+        // and closing it kills anything the tool left running
+        HANDLE job = CreateJobObjectA(nullptr, nullptr);
+        if (job) {
+            JOBOBJECT_EXTENDED_LIMIT_INFORMATION jobLimits{};
+            jobLimits.BasicLimitInformation.LimitFlags = JOB_OBJECT_LIMIT_KILL_ON_JOB_CLOSE;
+            if (options.limits.cpuSeconds > 0.0) {
+                jobLimits.BasicLimitInformation.LimitFlags |= JOB_OBJECT_LIMIT_JOB_TIME;
+                jobLimits.BasicLimitInformation.PerJobUserTimeLimit.QuadPart = static_cast<LONGLONG>(options.limits.cpuSeconds * 1e7);
+            }
+            SetInformationJobObject(job, JobObjectExtendedLimitInformation, &jobLimits, sizeof(jobLimits));
+        }
+
+        // CREATE_NO_WINDOW keeps a console from flashing up for every tool;
+        // it starts suspended so nothing runs before it is in the job
+        PROCESS_INFORMATION process{};
+        const Clock::time_point launched = Clock::now();
+        const BOOL created = CreateProcessA(nullptr, commandLine.data(), nullptr, nullptr, TRUE,
+                                            CREATE_NO_WINDOW | CREATE_SUSPENDED | EXTENDED_STARTUPINFO_PRESENT,
+                                            nullptr, nullptr, &startup.StartupInfo, &process);
+        if (!created) result.error = LastErrorMessage("CreateProcess");
+
+        DeleteProcThreadAttributeList(attributes);
+        CloseHandle(writePipe);
+        if (nul != INVALID_HANDLE_VALUE) CloseHandle(nul);
+        if (!created) {
+            CloseHandle(readPipe);
+            if (job) CloseHandle(job);
+            return;
+        }
+        if (job && !AssignProcessToJobObject(job, process.hProcess)) {
+            CloseHandle(job);
+            job = nullptr;
+        }
+        ResumeThread(process.hThread);
+        result.started = true;
+
+        // ReadFile on an anonymous pipe cannot time out, so a second thread
+        // enforces the deadlines; terminating the job closes the pipe
+        Watchdog watchdog(options.limits, launched);
+        HANDLE readDone = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+        std::atomic<ProcessStop> stop = ProcessStop::Exited;
+        std::thread enforcer;
+        if (readDone && (options.limits.wallSeconds > 0.0 || options.limits.idleSeconds > 0.0)) {
+            enforcer = std::thread([&] {
+                for (;;) {
+                    const long long wait = MillisecondsUntil(watchdog.NextDeadline());
+                    if (WaitForSingleObject(readDone, static_cast<DWORD>(wait)) != WAIT_TIMEOUT) return;
+                    const ProcessStop expired = watchdog.Check(Clock::now());
+                    if (expired == ProcessStop::Exited) continue;
+                    stop = expired;
+                    if (job) TerminateJobObject(job, 1);
+                    else TerminateProcess(process.hProcess, 1);
+                    return;
+                }
+            });
+        }
+
+        result.output.reserve(options.outputReserve);
+        for (;;) {
+            const size_t size = result.output.size();
+            result.output.resize(size + READ_CHUNK);
+            DWORD bytesRead = 0;
+            const BOOL ok = ReadFile(readPipe, result.output.data() + size, static_cast<DWORD>(READ_CHUNK), &bytesRead, nullptr);
+            result.output.resize(size + bytesRead);
+            if (!ok || bytesRead == 0) break;
+            watchdog.Output();
+            if (options.onOutput) options.onOutput(std::string_view(result.output).substr(size));
+        }
+        CloseHandle(readPipe);
+
+        WaitForSingleObject(process.hProcess, INFINITE);
+        result.wallSeconds = SecondsSince(launched);
+        if (readDone) SetEvent(readDone);
+        if (enforcer.joinable()) enforcer.join();
+        if (readDone) CloseHandle(readDone);
+        result.stop = stop;
+
+        DWORD exitCode = 0;
+        if (GetExitCodeProcess(process.hProcess, &exitCode)) result.exitCode = static_cast<int>(exitCode);
+
+        // Job accounting covers every process the tool started
+        JOBOBJECT_BASIC_ACCOUNTING_INFORMATION accounting{};
+        FILETIME creation, exit, kernel, user;
+        if (job && QueryInformationJobObject(job, JobObjectBasicAccountingInformation, &accounting, sizeof(accounting), nullptr)) {
+            result.userSeconds = accounting.TotalUserTime.QuadPart / 1e7;
+            result.systemSeconds = accounting.TotalKernelTime.QuadPart / 1e7;
+        } else if (GetProcessTimes(process.hProcess, &creation, &exit, &kernel, &user)) {
+            result.userSeconds = FileTimeSeconds(user);
+            result.systemSeconds = FileTimeSeconds(kernel);
+        }
+        if (result.stop == ProcessStop::Exited && options.limits.cpuSeconds > 0.0 && result.userSeconds >= options.limits.cpuSeconds) {
+            result.stop = ProcessStop::CpuLimit;
+        }
+        PROCESS_MEMORY_COUNTERS memory{};
+        if (K32GetProcessMemoryInfo(process.hProcess, &memory, sizeof(memory))) {
+            result.maxRssBytes = memory.PeakWorkingSetSize;
+        }
+
+        CloseHandle(process.hThread);
+        CloseHandle(process.hProcess);
+        if (job) CloseHandle(job);
+    }
+#else
+    std::string ErrnoMessage(const char* what, int error) {
+        return std::string(what) + " failed: " + std::strerror(error);
+    }
+
+    // Pipe ends must not leak into children launched concurrently by other
+    // threads, or their copy of the write end keeps our reader from seeing EOF
+    bool OpenPipe(int fds[2]) {
+#ifdef __linux__
+        return pipe2(fds, O_CLOEXEC) == 0;
+#else
+        if (pipe(fds) != 0) return false;
+        fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+        fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+        return true;
+#endif
+    }
+
+    void RunChild(const std::vector<std::string>& argv, const ProcessOptions& options, ProcessResult& result) {
+        int fds[2];
+        if (!OpenPipe(fds)) {
+            result.error = ErrnoMessage("pipe", errno);
+            return;
+        }
+
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+        posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);   // dup2 clears CLOEXEC
+        if (options.mergeStderr) posix_spawn_file_actions_adddup2(&actions, fds[1], STDERR_FILENO);
+
+        // A process group of its own, so a stop reaches everything the tool
+        // started (the decimation script runs ea_non_iid underneath perl)
+        posix_spawnattr_t attributes;
+        posix_spawnattr_init(&attributes);
+        posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETPGROUP);
+        posix_spawnattr_setpgroup(&attributes, 0);
+
+        std::vector<char*> args;
+        for (const auto& arg : argv) args.push_back(const_cast<char*>(arg.c_str()));
+        args.push_back(nullptr);
+
+        pid_t pid = 0;
+        const Clock::time_point launched = Clock::now();
+        const int spawned = posix_spawnp(&pid, args[0], &actions, &attributes, args.data(), environ);
+        posix_spawn_file_actions_destroy(&actions);
+        posix_spawnattr_destroy(&attributes);
+        close(fds[1]);
+        if (spawned != 0) {
+            close(fds[0]);
+            result.error = ErrnoMessage(("posix_spawnp " + argv[0]).c_str(), spawned);
+            return;
+        }
+        result.started = true;
+
+#ifdef __linux__
+        if (options.limits.cpuSeconds > 0.0) {
+            // SIGXCPU at the soft limit, SIGKILL a second later; children
+            // forked afterwards inherit it
+            const rlim_t seconds = static_cast<rlim_t>(std::ceil(options.limits.cpuSeconds));
+            const rlimit cpu{ seconds, seconds + 1 };
+            prlimit(pid, RLIMIT_CPU, &cpu, nullptr);
+        }
+#endif
+
+        // Signals go to the group only while the leader is unreaped, so its
+        // pid cannot have been reused
+        Watchdog watchdog(options.limits, launched);
+        Clock::time_point escalateAt = Clock::time_point::max();
+        bool killed = false;
+        auto nextDeadline = [&] { return result.stop == ProcessStop::Exited ? watchdog.NextDeadline() : escalateAt; };
+        // Stops or escalates once a deadline has passed; true once the tree
+        // has been killed and given time to go. Nothing is left to enforce
+        // then, so the deadline is cleared and waiting for the leader blocks
+        // (it may sit in uninterruptible sleep for a while yet).
+        auto enforce = [&](Clock::time_point now) {
+            if (result.stop == ProcessStop::Exited) {
+                result.stop = watchdog.Check(now);
+                if (result.stop != ProcessStop::Exited) {
+                    kill(-pid, SIGTERM);
+                    escalateAt = now + STOP_GRACE;
+                }
+            } else if (now >= escalateAt) {
+                if (killed) {
+                    escalateAt = Clock::time_point::max();
+                    return true;
+                }
+                kill(-pid, SIGKILL);
+                killed = true;
+                escalateAt = now + STOP_GRACE;
+            }
+            return false;
+        };
+
+        result.output.reserve(options.outputReserve);
+        pollfd reader{ fds[0], POLLIN, 0 };
+        for (;;) {
+            const int ready = poll(&reader, 1, static_cast<int>(MillisecondsUntil(nextDeadline())));
+            if (ready < 0 && errno != EINTR) break;
+            if (ready > 0) {
+                const size_t size = result.output.size();
+                result.output.resize(size + READ_CHUNK);
+                const ssize_t bytesRead = read(fds[0], result.output.data() + size, READ_CHUNK);
+                result.output.resize(size + std::max<ssize_t>(bytesRead, 0));
+                if (bytesRead > 0) {
+                    watchdog.Output();
+                    if (options.onOutput) options.onOutput(std::string_view(result.output).substr(size));
+                    continue;
+                }
+                if (bytesRead < 0 && errno == EINTR) continue;
+                break;
+            }
+            // Something that left the group can still hold the pipe open
+            // after the kill; stop reading rather than wait for it
+            if (ready == 0 && enforce(Clock::now())) break;
+        }
+        close(fds[0]);
+
+        // The tool may close stdout and keep running, so the limits still
+        // apply while waiting for it to exit
+        int status = 0;
+        rusage usage{};
+        int exitFd = -1;
+        auto backoff = std::chrono::microseconds(100);
+        for (;;) {
+            const pid_t reaped = wait4(pid, &status, nextDeadline() == Clock::time_point::max() ? 0 : WNOHANG, &usage);
+            if (reaped == pid) break;
+            if (reaped < 0) {
+                if (errno == EINTR) continue;
+                break;
+            }
+            if (Clock::now() >= nextDeadline()) enforce(Clock::now());
+#ifdef __linux__
+            // A pidfd becomes readable when the child exits
+            if (exitFd < 0) exitFd = static_cast<int>(syscall(SYS_pidfd_open, pid, 0));
+            if (exitFd >= 0) {
+                pollfd exited{ exitFd, POLLIN, 0 };
+                poll(&exited, 1, static_cast<int>(MillisecondsUntil(nextDeadline())));
+                continue;
+            }
+#endif
+            std::this_thread::sleep_for(backoff);
+            backoff = std::min<std::chrono::microseconds>(backoff * 2, std::chrono::milliseconds(50));
+        }
+        if (exitFd >= 0) close(exitFd);
+        result.wallSeconds = SecondsSince(launched);
+
+        if (WIFEXITED(status)) result.exitCode = WEXITSTATUS(status);
+        else if (WIFSIGNALED(status)) result.exitCode = 128 + WTERMSIG(status);
+
+        result.userSeconds = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6;
+        result.systemSeconds = usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+        if (result.stop == ProcessStop::Exited && options.limits.cpuSeconds > 0.0 && WIFSIGNALED(status)
+            && (WTERMSIG(status) == SIGXCPU || result.userSeconds + result.systemSeconds >= options.limits.cpuSeconds)) {
+            result.stop = ProcessStop::CpuLimit;
+        }
+#ifdef __APPLE__
+        result.maxRssBytes = static_cast<uint64_t>(usage.ru_maxrss);            // bytes
+#else
+        result.maxRssBytes = static_cast<uint64_t>(usage.ru_maxrss) * 1024;     // KiB
+#endif
+    }
+#endif
+}
+
+const char* ToString(ProcessStop stop) {
+    switch (stop) {
+        case ProcessStop::Exited: return "exited";
+        case ProcessStop::WallLimit: return "wall-clock limit";
+        case ProcessStop::CpuLimit: return "CPU limit";
+        case ProcessStop::Stalled: return "idle limit";
+    }
+    return "unknown";
+}
+
+double ProcessLimits::For(ProcessStop stop) const {
+    switch (stop) {
+        case ProcessStop::Exited: return 0.0;
+        case ProcessStop::WallLimit: return wallSeconds;
+        case ProcessStop::CpuLimit: return cpuSeconds;
+        case ProcessStop::Stalled: return idleSeconds;
+    }
+    return 0.0;
+}
+
+std::string ProcessResult::Summary() const {
+    if (!started) return error;
+
+    char resources[128];
+    std::snprintf(resources, sizeof(resources), "%.1f s wall, %.1f s CPU, %llu MiB peak, %.1f s queued",
+                  wallSeconds, userSeconds + systemSeconds, static_cast<unsigned long long>(maxRssBytes >> 20), queuedSeconds);
+    if (stop == ProcessStop::Exited) {
+        return "exit code " + std::to_string(exitCode) + " (" + resources + ")";
+    }
+    char limit[32];
+    std::snprintf(limit, sizeof(limit), " of %g s", limitSeconds);
+    return std::string("stopped: ") + ToString(stop) + limit + " (" + resources + ")";
+}
+
+std::string ProcessResult::StatusLine() const {
+    return "*** " + (started ? "Run " + Summary() : "Could not start: " + error) + " ***\n";
+}
+
+ProcessError::ProcessError(std::string tool, ProcessResult result)
+    : std::runtime_error(tool + ": " + result.Summary())
+    , m_tool(std::move(tool))
+    , m_result(std::move(result))
+{}
+
+std::string ProcessError::PartialLog() const {
+    std::string log = m_result.output;
+    if (!log.empty() && log.back() != '\n') log += '\n';
+    log += m_result.StatusLine();
+    return log;
+}
+
+ProcessExecutor::ProcessExecutor(size_t maxConcurrent)
+    : m_maxConcurrent(std::max<size_t>(1, maxConcurrent))
+{}
+
+ProcessExecutor& ProcessExecutor::Shared() {
+    static ProcessExecutor executor(DefaultConcurrency());
+    return executor;
+}
+
+size_t ProcessExecutor::DefaultConcurrency() {
+    // The 90B tools are CPU-bound; leave room for the pipeline's own workers
+    return std::max(1u, std::thread::hardware_concurrency() / 2);
+}
+
+void ProcessExecutor::SetMaxConcurrent(size_t maxConcurrent) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_maxConcurrent = std::max<size_t>(1, maxConcurrent);
+    }
+    m_admitted.notify_all();
+}
+
+size_t ProcessExecutor::MaxConcurrent() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_maxConcurrent;
+}
+
+size_t ProcessExecutor::Running() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_running;
+}
+
+size_t ProcessExecutor::Waiting() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<size_t>(m_nextTicket - m_nowServing);
+}
+
+void ProcessExecutor::Acquire() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const uint64_t ticket = m_nextTicket++;
+    m_admitted.wait(lock, [&] { return ticket == m_nowServing && m_running < m_maxConcurrent; });
+    ++m_nowServing;
+    ++m_running;
+    lock.unlock();
+    m_admitted.notify_all();    // the next ticket may fit too
+}
+
+void ProcessExecutor::Release() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        --m_running;
+    }
+    m_admitted.notify_all();
+}
+
+ProcessResult ProcessExecutor::Run(const std::vector<std::string>& argv, const ProcessOptions& options) {
+    ProcessResult result;
+    if (argv.empty()) {
+        result.error = "Empty command";
+        return result;
+    }
+
+    const Clock::time_point queued = Clock::now();
+    {
+        TRACE_SCOPE("tool.queue");
+        Acquire();
+    }
+    result.queuedSeconds = SecondsSince(queued);
+
+    try {
+        RunChild(argv, options, result);
+        result.limitSeconds = options.limits.For(result.stop);
+    } catch (...) {
+        Release();
+        throw;
+    }
+    Release();
+    return result;
+}
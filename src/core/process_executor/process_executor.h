@@ -0,0 +1,125 @@
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Why a run ended
+enum class ProcessStop {
+    Exited,         // on its own (see exitCode)
+    WallLimit,      // ran longer than ProcessLimits::wallSeconds
+    CpuLimit,       // used more CPU than ProcessLimits::cpuSeconds
+    Stalled         // wrote nothing for ProcessLimits::idleSeconds
+};
+
+const char* ToString(ProcessStop stop);
+
+// Watchdog limits for one run; 0 turns a limit off. A run that exceeds one is
+// stopped along with everything it started.
+struct ProcessLimits {
+    double wallSeconds = 0.0;
+    double cpuSeconds = 0.0;        // per process on Linux (RLIMIT_CPU), user time of the whole tree on Windows
+    double idleSeconds = 0.0;       // longest gap between output chunks; only for tools that flush each line
+
+    bool Any() const { return wallSeconds > 0.0 || cpuSeconds > 0.0 || idleSeconds > 0.0; }
+    // The limit behind a stop; 0 for Exited
+    double For(ProcessStop stop) const;
+};
+
+// Outcome of one external tool run
+struct ProcessResult {
+    bool started = false;           // false: the process could not be launched (see error)
+    int exitCode = -1;              // 128 + signal when killed by a signal
+    ProcessStop stop = ProcessStop::Exited;
+    double limitSeconds = 0.0;      // the limit that stopped it, if stop is not Exited
+    std::string output;             // everything the child wrote to stdout
+    std::string error;
+
+    double queuedSeconds = 0.0;     // waiting for a free slot
+    double wallSeconds = 0.0;       // launch to exit
+    double userSeconds = 0.0;
+    double systemSeconds = 0.0;
+    uint64_t maxRssBytes = 0;       // peak resident set (peak working set on Windows)
+
+    bool Succeeded() const { return started && stop == ProcessStop::Exited && exitCode == 0; }
+    // One line for logs: what happened and the resources used
+    std::string Summary() const;
+    // "*** Run exit code 2 (...) ***" for the end of a tool's result file
+    std::string StatusLine() const;
+};
+
+struct ProcessOptions {
+    size_t outputReserve = 256 << 10;
+    bool mergeStderr = false;       // capture stderr along with stdout (2>&1)
+    ProcessLimits limits;
+    // Called with each chunk as it is read, on the thread calling Run; chunks
+    // split lines anywhere. The output string still receives everything.
+    std::function<void(std::string_view)> onOutput;
+};
+
+// Thrown by executeCommand when a tool cannot be started or is stopped by its
+// limits; carries the full result, including any output written before then
+class ProcessError : public std::runtime_error {
+private:
+    std::string m_tool;
+    ProcessResult m_result;
+
+public:
+    ProcessError(std::string tool, ProcessResult result);
+
+    const std::string& Tool() const { return m_tool; }
+    const ProcessResult& Result() const { return m_result; }
+
+    // For the tool's result file: the output written before the stop, then a
+    // line with the reason, the limit hit and the resources used
+    std::string PartialLog() const;
+};
+
+// Launches external tools with a cap on how many run at once, independent of
+// the CPU thread pool: pool workers may block in Run while their tool waits
+// for a slot. Waiting callers are admitted in arrival order.
+//
+// Tools are started directly from an argument vector (posix_spawnp on POSIX,
+// CreateProcess on Windows), with no shell in between and no quoting to get
+// wrong. stdout is read through a pipe straight into a pre-reserved string;
+// stdin is the null device, and stderr is inherited unless merged (discarded
+// on Windows, where the GUI has no console).
+//
+// Each child gets its own process group (a job object on Windows) so a
+// watchdog stop takes down the whole tree: SIGTERM, then SIGKILL after a
+// grace period on POSIX; TerminateJobObject on Windows.
+class ProcessExecutor {
+private:
+    mutable std::mutex m_mutex;
+    std::condition_variable m_admitted;
+    size_t m_maxConcurrent;
+    size_t m_running = 0;
+    uint64_t m_nextTicket = 0;      // handed out in arrival order
+    uint64_t m_nowServing = 0;      // lowest ticket not yet admitted
+
+    void Acquire();
+    void Release();
+
+public:
+    explicit ProcessExecutor(size_t maxConcurrent);
+
+    // The executor shared by executeCommand callers (GUI and batch runner)
+    static ProcessExecutor& Shared();
+    static size_t DefaultConcurrency();
+
+    // Takes effect for the next admission; running children are not affected
+    void SetMaxConcurrent(size_t maxConcurrent);
+    size_t MaxConcurrent() const;
+    size_t Running() const;
+    size_t Waiting() const;
+
+    // Runs argv[0] (looked up on PATH) with the rest as arguments; blocks until it exits
+    ProcessResult Run(const std::vector<std::string>& argv, const ProcessOptions& options = {});
+};
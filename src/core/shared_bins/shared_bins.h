@@ -0,0 +1,53 @@
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Immutable, heap-backed bin storage shared between copies.
+//
+// Copying a histogram (and so an OE or a whole Project snapshot) only bumps a
+// reference count. Bins are never edited in place: build a std::vector and
+// assign it, which publishes a new block and leaves other copies untouched.
+// An empty SharedBins holds no allocation at all.
+//
+// Every published block gets a process-unique version (0 when empty), so
+// derived data such as plot buffers can tell "same bins" from "new bins"
+// without comparing contents or trusting a recycled address.
+template<typename T>
+class SharedBins {
+private:
+    std::shared_ptr<const std::vector<T>> m_values;
+    uint64_t m_version = 0;
+
+    static uint64_t NextVersion() {
+        static std::atomic<uint64_t> counter{ 0 };
+        return ++counter;
+    }
+
+    static const std::vector<T>& Empty() {
+        static const std::vector<T> empty;
+        return empty;
+    }
+
+public:
+    SharedBins() = default;
+    SharedBins(std::vector<T> values)
+        : m_values(values.empty() ? nullptr : std::make_shared<const std::vector<T>>(std::move(values)))
+        , m_version(m_values ? NextVersion() : 0)
+    {}
+
+    const std::vector<T>& values() const { return m_values ? *m_values : Empty(); }
+    uint64_t version() const { return m_version; }
+
+    size_t size() const { return values().size(); }
+    bool empty() const { return values().empty(); }
+    const T* data() const { return values().data(); }
+    const T& operator[](size_t i) const { return (*m_values)[i]; }
+
+    typename std::vector<T>::const_iterator begin() const { return values().begin(); }
+    typename std::vector<T>::const_iterator end() const { return values().end(); }
+};
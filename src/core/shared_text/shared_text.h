@@ -0,0 +1,36 @@
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+// Immutable text shared between copies. Tool output can run to megabytes, so
+// copying a result (or the OE/Project holding it) only bumps a reference count.
+// Assigning publishes a new string and leaves other copies untouched.
+class SharedText {
+private:
+    std::shared_ptr<const std::string> m_text;
+
+    static const std::string& Empty() {
+        static const std::string empty;
+        return empty;
+    }
+
+public:
+    SharedText() = default;
+    SharedText(std::string text)
+        : m_text(text.empty() ? nullptr : std::make_shared<const std::string>(std::move(text)))
+    {}
+    SharedText(const char* text) : SharedText(std::string(text)) {}
+
+    const std::string& str() const { return m_text ? *m_text : Empty(); }
+    operator const std::string&() const { return str(); }
+
+    bool empty() const { return !m_text; }
+    size_t size() const { return str().size(); }
+    const char* c_str() const { return str().c_str(); }
+
+    // The underlying buffer, for consumers that index the text off the UI thread
+    const std::shared_ptr<const std::string>& shared() const { return m_text; }
+};
@@ -0,0 +1,91 @@
+
+#include "tool_config.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <mutex>
+
+namespace {
+    std::mutex g_mutex;
+
+    ToolConfig& CurrentConfig() {
+        static ToolConfig config;
+        return config;
+    }
+
+    // Host root of the default WSL distro (e.g. \\wsl.localhost\Ubuntu), as WSL
+    // itself reports it; asked once, since it needs a launch
+    std::filesystem::path DefaultDistroRoot() {
+        static const std::filesystem::path root = [] {
+            ProcessResult result = ProcessExecutor::Shared().Run({ "wsl", "--exec", "wslpath", "-w", "/" });
+            std::string path = result.Succeeded() ? result.output : std::string();
+            while (!path.empty() && std::isspace(static_cast<unsigned char>(path.back()))) path.pop_back();
+            if (path.empty()) std::cerr << "Could not locate the default WSL distro: " << result.Summary() << std::endl;
+            return std::filesystem::path(path);
+        }();
+        return root;
+    }
+}
+
+std::vector<std::string> ToolConfig::Command(const std::string& tool, std::vector<std::string> args, bool streamed) const {
+    std::vector<std::string> argv;
+    if (useWsl) {
+        argv = { "wsl" };
+        if (!wslDistro.empty()) argv.insert(argv.end(), { "-d", wslDistro });
+        argv.push_back("--exec");
+    }
+#ifdef _WIN32
+    const bool posixTool = useWsl;
+#else
+    const bool posixTool = true;
+#endif
+    if (streamed && posixTool && !lineBuffer.empty()) argv.insert(argv.end(), { lineBuffer, "-oL" });
+    argv.push_back(tool);
+    argv.insert(argv.end(), std::make_move_iterator(args.begin()), std::make_move_iterator(args.end()));
+    return argv;
+}
+
+const std::string* ToolConfig::WrappedTool(const std::vector<std::string>& argv) const {
+    if (lineBuffer.empty()) return nullptr;
+    for (size_t i = 0; i + 2 < argv.size(); ++i) {
+        if (argv[i] == lineBuffer && argv[i + 1] == "-oL") return &argv[i + 2];
+    }
+    return nullptr;
+}
+
+std::string ToolConfig::ToolPath(const std::filesystem::path& hostPath) const {
+    std::string path = hostPath.string();
+    if (!useWsl) return path;
+
+    std::replace(path.begin(), path.end(), '\\', '/');
+    if (path.size() > 2 && path[1] == ':') {
+        char driveLetter = static_cast<char>(std::tolower(static_cast<unsigned char>(path[0])));
+        path = "/mnt/" + std::string(1, driveLetter) + path.substr(2);
+    }
+    return path;
+}
+
+std::filesystem::path ToolConfig::HostPath(const std::string& toolPath) const {
+    if (!useWsl) return std::filesystem::path(toolPath);
+
+    std::string relative = toolPath;
+    if (relative.starts_with("/mnt/") && relative.size() >= 6 && (relative.size() == 6 || relative[6] == '/')) {
+        // Back onto the Windows drive it came from
+        const char driveLetter = static_cast<char>(std::toupper(static_cast<unsigned char>(relative[5])));
+        return std::filesystem::path(std::string(1, driveLetter) + ":" + (relative.size() == 6 ? "/" : relative.substr(6)));
+    }
+    while (!relative.empty() && relative.front() == '/') relative.erase(relative.begin());
+    if (wslDistro.empty()) return DefaultDistroRoot() / relative;
+    return std::filesystem::path("\\\\wsl$\\" + wslDistro) / relative;
+}
+
+ToolConfig ToolConfig::Current() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    return CurrentConfig();
+}
+
+void ToolConfig::SetCurrent(const ToolConfig& config) {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    CurrentConfig() = config;
+}
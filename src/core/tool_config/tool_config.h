@@ -0,0 +1,55 @@
+
+#pragma once
+
+#include "../process_executor/process_executor.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Where the external SP 800-90B tools live and how they are launched. On
+// Windows they run inside WSL by default; pointing the entries at native
+// builds and turning useWsl off skips the WSL start-up on every launch.
+// Stored under "tools" in app.json; the batch runner takes --tools FILE.
+// How many run at once is app.json's "toolJobs" (--tool-jobs for the batch runner).
+struct ToolConfig {
+    std::string nonIid = "ea_non_iid";
+    std::string restart = "ea_restart";
+    std::string perl = "perl";
+    std::string decimationScript = "/home/user/tools/find-first-passing-decimation.pl";
+#ifdef _WIN32
+    bool useWsl = true;
+#else
+    bool useWsl = false;
+#endif
+    std::string wslDistro;              // empty: the user's default distro
+    // Run as "<lineBuffer> -oL <tool>" when the output is read as it arrives;
+    // a tool writing to a pipe otherwise holds everything back until it exits.
+    // Ignored for native Windows tools; empty turns it off.
+#ifdef __APPLE__
+    std::string lineBuffer;
+#else
+    std::string lineBuffer = "stdbuf";
+#endif
+
+    // Watchdog limits per tool; all off unless configured. A tool with an idle
+    // limit is run line-buffered; the decimation script ignores idleSeconds.
+    ProcessLimits nonIidLimits;
+    ProcessLimits restartLimits;
+    ProcessLimits decimationLimits;     // the whole perl run, including its ea_non_iid calls
+
+    // argv running tool with args, through "wsl --exec" when useWsl is set
+    std::vector<std::string> Command(const std::string& tool, std::vector<std::string> args, bool streamed = false) const;
+    // The tool argv starts through the lineBuffer wrapper, or nullptr if it is
+    // run directly. stdbuf exits 126/127 when it cannot run the tool at all.
+    const std::string* WrappedTool(const std::vector<std::string>& argv) const;
+
+    // A host path as the tools see it (/mnt/<drive>/... under WSL)
+    std::string ToolPath(const std::filesystem::path& hostPath) const;
+    // A tool-side path as the host sees it (\\wsl$\<distro>\... under WSL)
+    std::filesystem::path HostPath(const std::string& toolPath) const;
+
+    // Process-wide settings, read by every launch
+    static ToolConfig Current();
+    static void SetCurrent(const ToolConfig& config);
+};
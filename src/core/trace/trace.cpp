@@ -0,0 +1,202 @@
+
+#include "trace.h"
+
+#include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Trace {
+    namespace {
+        struct Event {
+            const char* name;
+            int64_t start;      // ns since the trace epoch
+            int64_t duration;   // ns
+            ContextId context;
+            std::vector<Arg> args;
+        };
+
+        struct ThreadBuffer {
+            uint32_t tid = 0;
+            std::string name;
+            std::mutex mutex;   // only contended while exporting or clearing
+            std::vector<Event> events;
+        };
+
+        struct Context {
+            std::string oe;
+            int region = -1;
+        };
+
+        struct Registry {
+            std::mutex mutex;
+            std::vector<std::unique_ptr<ThreadBuffer>> buffers;     // owned here so spans outlive their threads
+            std::vector<Context> contexts{ Context{} };            // id 0 = no context
+        };
+
+        std::atomic<bool> g_enabled{false};
+        thread_local ThreadBuffer* t_buffer = nullptr;
+        thread_local ContextId t_context = 0;
+        thread_local Scope* t_open = nullptr;      // innermost recording span
+
+        Registry& GetRegistry() {
+            static Registry registry;
+            return registry;
+        }
+
+        int64_t NowNs() {
+            static const auto epoch = std::chrono::steady_clock::now();
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+        }
+
+        ThreadBuffer& LocalBuffer() {
+            if (!t_buffer) {
+                auto& registry = GetRegistry();
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                auto buffer = std::make_unique<ThreadBuffer>();
+                buffer->tid = static_cast<uint32_t>(registry.buffers.size() + 1);
+                buffer->events.reserve(4096);
+                t_buffer = buffer.get();
+                registry.buffers.push_back(std::move(buffer));
+            }
+            return *t_buffer;
+        }
+
+        ContextId Intern(const std::string& oe, int region) {
+            auto& registry = GetRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            for (size_t i = 0; i < registry.contexts.size(); ++i) {
+                if (registry.contexts[i].oe == oe && registry.contexts[i].region == region) return static_cast<ContextId>(i);
+            }
+            registry.contexts.push_back({ oe, region });
+            return static_cast<ContextId>(registry.contexts.size() - 1);
+        }
+    }
+
+    void SetEnabled(bool enabled) {
+        NowNs(); // pin the epoch before the first span
+        g_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool Enabled() {
+        return g_enabled.load(std::memory_order_relaxed);
+    }
+
+    void Clear() {
+        auto& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (auto& buffer : registry.buffers) {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            buffer->events.clear();
+        }
+    }
+
+    void SetThreadName(const std::string& name) {
+        auto& buffer = LocalBuffer();
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        buffer.name = name;
+    }
+
+    bool WriteChromeTrace(const std::filesystem::path& path) {
+        nlohmann::json events = nlohmann::json::array();
+
+        {
+            auto& registry = GetRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+
+            for (auto& buffer : registry.buffers) {
+                std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+
+                std::string threadName = buffer->name.empty() ? "thread " + std::to_string(buffer->tid) : buffer->name;
+                events.push_back({
+                    {"name", "thread_name"}, {"ph", "M"}, {"pid", 1}, {"tid", buffer->tid},
+                    {"args", {{"name", threadName}}}
+                });
+
+                for (const auto& e : buffer->events) {
+                    nlohmann::json event = {
+                        {"name", e.name}, {"cat", "pipeline"}, {"ph", "X"}, {"pid", 1}, {"tid", buffer->tid},
+                        {"ts", e.start / 1000.0}, {"dur", e.duration / 1000.0}
+                    };
+                    const auto& context = registry.contexts[e.context];
+                    if (!context.oe.empty()) event["args"]["oe"] = context.oe;
+                    if (context.region >= 0) event["args"]["region"] = context.region;
+                    for (const auto& [key, value] : e.args) {
+                        std::visit([&, key = key](const auto& v) { event["args"][key] = v; }, value);
+                    }
+                    events.push_back(std::move(event));
+                }
+            }
+        }
+
+        std::ofstream out(path, std::ios::out | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Failed to write trace file: " << path << "\n";
+            return false;
+        }
+        out << nlohmann::json{ {"traceEvents", events}, {"displayTimeUnit", "ms"} }.dump();
+        return out.good();
+    }
+
+    ContextId CurrentContext() {
+        return t_context;
+    }
+
+    ContextScope::ContextScope(const std::string& oe, int region)
+        : m_previous(t_context)
+    {
+        t_context = Intern(oe, region);
+    }
+
+    ContextScope::ContextScope(int region)
+        : m_previous(t_context)
+    {
+        std::string oe;
+        {
+            auto& registry = GetRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            oe = registry.contexts[t_context].oe;
+        }
+        t_context = Intern(oe, region);
+    }
+
+    ContextScope::ContextScope(ContextId context)
+        : m_previous(t_context)
+    {
+        t_context = context;
+    }
+
+    ContextScope::~ContextScope() {
+        t_context = m_previous;
+    }
+
+    Scope::Scope(const char* name)
+        : m_name(Enabled() ? name : nullptr), m_start(m_name ? NowNs() : 0)
+    {
+        if (!m_name) return;
+        m_parent = t_open;
+        t_open = this;
+    }
+
+    Scope::~Scope() {
+        if (!m_name) return;
+        t_open = m_parent;
+        int64_t end = NowNs();
+        auto& buffer = LocalBuffer();
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        buffer.events.push_back({ m_name, m_start, end - m_start, t_context, std::move(m_args) });
+    }
+
+    void Annotate(const char* key, double value) {
+        if (t_open) t_open->m_args.emplace_back(key, value);
+    }
+
+    void Annotate(const char* key, std::string value) {
+        if (t_open) t_open->m_args.emplace_back(key, std::move(value));
+    }
+}
@@ -0,0 +1,80 @@
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+// Lightweight span tracing for the pipeline, exported as Chrome trace JSON
+// (chrome://tracing, ui.perfetto.dev).
+//
+// Spans are recorded into a per-thread buffer, so recording never contends with
+// other threads. Each span carries the thread's current context (OE name and
+// region index), set with Trace::ContextScope by whoever knows it. Tracing is
+// off by default; a disabled TRACE_SCOPE costs one relaxed atomic load.
+namespace Trace {
+    void SetEnabled(bool enabled);
+    bool Enabled();
+
+    // Drops every recorded span (buffers stay registered)
+    void Clear();
+
+    // Writes everything recorded so far as {"traceEvents": [...]}
+    bool WriteChromeTrace(const std::filesystem::path& path);
+
+    // Names the calling thread in the exported timeline
+    void SetThreadName(const std::string& name);
+
+    // Interned (OE, region) pair; 0 means "no context"
+    using ContextId = uint32_t;
+    ContextId CurrentContext();
+
+    // Sets the calling thread's context for its lifetime, restoring the previous one after
+    class ContextScope {
+    private:
+        ContextId m_previous;
+
+    public:
+        ContextScope(const std::string& oe, int region = -1);
+        explicit ContextScope(int region);          // keeps the current OE
+        explicit ContextScope(ContextId context);   // adopt a context captured on another thread
+        ~ContextScope();
+
+        ContextScope(const ContextScope&) = delete;
+        ContextScope& operator=(const ContextScope&) = delete;
+    };
+
+    // Value of a span argument, shown under "args" in the exported event
+    using Arg = std::pair<const char*, std::variant<double, std::string>>;
+
+    // Records [construction, destruction) as a span. name must outlive the trace (use literals).
+    class Scope {
+    private:
+        const char* m_name;
+        int64_t m_start;
+        Scope* m_parent = nullptr;      // enclosing open span on this thread
+        std::vector<Arg> m_args;
+
+        friend void Annotate(const char* key, double value);
+        friend void Annotate(const char* key, std::string value);
+
+    public:
+        explicit Scope(const char* name);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    // Attaches key = value to the innermost open span on the calling thread;
+    // does nothing when tracing is off or no span is open. key: a literal.
+    void Annotate(const char* key, double value);
+    void Annotate(const char* key, std::string value);
+}
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) ::Trace::Scope TRACE_CONCAT(traceScope_, __LINE__)(name)
@@ -3,18 +3,28 @@
 
 //#include "../data/histogram/histogram.h"
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <future>
 #include <string>
 #include <vector>
 #include <filesystem>
+#include <memory>
 #include <optional>
-#include <regex>
 
 #include <imgui.h>
 #include <implot.h>
 #include <lib90b/entropy_tests.h>
 #include <lib90b/non_iid.h>
 
+#include "shared_bins/shared_bins.h"
+#include "shared_text/shared_text.h"
+#include "../data/result_parser/result_parser.h"
+
+class ValueIndex;
+
 enum class Tabs {
     StatisticalAssessment,
     HeuristicAssessment
@@ -39,48 +49,19 @@ struct NonIidParsedResults {
     double h_original = 0.0f;
     double h_bitstring = 0.0f;
 
-    bool ParseResult(const std::string& rawResultsOutput) {
-        // Extract H_original
-        std::regex h_original_pattern(R"(H_original:\s*([\d.]+))");
-        std::smatch h_original_match;
-        if (std::regex_search(rawResultsOutput, h_original_match, h_original_pattern)) {
-            try {
-                h_original = std::stod(h_original_match[1]);
-            } catch (...) {
-                return false;
-            }
-        } else {
-            return false;
-        }
-        
-        // Extract H_bitstring
-        std::regex h_bitstring_pattern(R"(H_bitstring:\s*([\d.]+))");
-        std::smatch h_bitstring_match;
-        if (std::regex_search(rawResultsOutput, h_bitstring_match, h_bitstring_pattern)) {
-            try {
-                h_bitstring = std::stod(h_bitstring_match[1]);
-            } catch (...) {
-                return false;
-            }
-        } else {
-            return false;
-        }
-        
-        // Extract min entropy
-        std::regex min_entropy_pattern(R"(min\(H_original, (?:\d+) X H_bitstring\):\s*([\d.]+))");
-        std::smatch min_entropy_match;
-        if (std::regex_search(rawResultsOutput, min_entropy_match, min_entropy_pattern)) {
-            try {
-                minEntropy = std::stod(min_entropy_match[1]);
-            } catch (...) {
-                return false;
-            }
-        } else {
-            return false;
-        }
-        
+    // Takes the summary of a streamed run; false if the run did not get that far
+    bool Assign(const NonIidReport& report) {
+        if (!report.Complete()) return false;
+        h_original = *report.hOriginal;
+        h_bitstring = *report.hBitstring;
+        minEntropy = *report.minEntropy;
         return true;
     }
+
+    // A stored ea_non_iid log, e.g. when reloading results
+    bool ParseResult(const std::string& rawResultsOutput) {
+        return Assign(ParseNonIid(rawResultsOutput));
+    }
 };
 
 struct StatisticData {
@@ -90,28 +71,37 @@ struct StatisticData {
     std::filesystem::path nonIidResultFilePath;
     std::filesystem::path restartResultFilePath;
 
-    std::string nonIidResult = "";
-    std::string restartResult = "";
+    SharedText nonIidResult;
+    SharedText restartResult;
 
     NonIidParsedResults nonIidParsedResults;
+    NonIidProgress nonIidProgress;      // per-estimator results of the current or last run
 
     TestTimer nonIidTestTimer;
     TestTimer restartTestTimer;
 };
 
+enum class SmoothingKernel {
+    Gaussian,
+    Box
+};
+
 struct BaseHistogram {
-    static constexpr int binCount = 1500;
+    static constexpr int defaultBinCount = 1500;
     unsigned int minValue = 0;
     unsigned int maxValue = 0;
     double binWidth = 0.0;
-    std::array<int, binCount> binCounts{};
+    SharedBins<int> binCounts;      // resolution is per dataset; empty until computed
+
+    int binCount() const { return static_cast<int>(binCounts.size()); }
 
     //lib90b::EntropyInputData entropyData;
     //lib90b::NonIidResult entropyResults;
     std::filesystem::path nonIidSampleFilePath;
     std::filesystem::path nonIidResultFilePath;
-    std::string nonIidResult = "";
+    SharedText nonIidResult;
     NonIidParsedResults nonIidParsedResults;
+    NonIidProgress nonIidProgress;      // per-estimator results of the current or last run
     
     TestTimer testTimer;
 };
@@ -129,6 +119,13 @@ struct MainHistogram : public BaseHistogram {
 
     std::vector<SubHistogram> subHists;
 
+    // binCounts hold the exact counts; this is the display copy, rebuilt by smoothHistogram
+    SharedBins<double> smoothedCounts;
+    SmoothingKernel smoothingKernel = SmoothingKernel::Gaussian;
+    double smoothingSigma = 1.5;    // in bins, 0 = no smoothing
+    int requestedBinCount = 0;      // used when the file is (re)processed, 0 = automatic
+    std::shared_ptr<const ValueIndex> valueIndex;   // exact per-value counts, not persisted; null until known
+
     TestTimer decimationTestTimer;
 };
 
@@ -137,11 +134,19 @@ struct HeuristicData {
 };
 
 struct OperationalEnvironment {
+    // Unique for the life of the process and kept by copies; not persisted. Background
+    // jobs find their OE by it, since names, paths and indexes change under them.
+    uint64_t id = NextId();
     std::string oeName;
     std::string oePath;
 
     StatisticData statisticData;
     HeuristicData heuristicData;
+
+    static uint64_t NextId() {
+        static std::atomic<uint64_t> s_lastId{ 0 };
+        return ++s_lastId;
+    }
 };
 
 struct Project {
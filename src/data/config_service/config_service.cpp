@@ -0,0 +1,160 @@
+
+#include "config_service.h"
+#include "../../file_utils/file_utils.h"
+
+#include <fstream>
+#include <iostream>
+
+ConfigService::ConfigService(std::chrono::milliseconds debounce)
+    : m_debounce(debounce)
+{
+    m_flushThread = std::thread([this] { FlushLoop(); });
+}
+
+ConfigService::~ConfigService() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_condition.notify_all();
+    if (m_flushThread.joinable()) m_flushThread.join();
+
+    // Don't lose a change that was still inside the debounce window
+    WritePending();
+}
+
+Config::AppConfig ConfigService::Load(const fs::path& appConfigPath, const fs::path& vendorListPath) {
+    Config::AppConfig config;
+
+    m_appConfigPath = appConfigPath;
+    m_vendorListPath = vendorListPath;
+
+    nlohmann::json document = nlohmann::json::object();
+
+    if (!fs::exists(appConfigPath)) {
+        std::cerr << "Config file does not exist: " << appConfigPath << std::endl;
+    } else {
+        std::ifstream in(appConfigPath);
+        if (!in.is_open()) {
+            std::cerr << "Failed to open config file: " << appConfigPath << std::endl;
+        } else {
+            try {
+                in >> document;
+                config = document.get<Config::AppConfig>();
+            } catch (const nlohmann::json::exception& e) {
+                std::cerr << "Failed to parse config JSON: " << e.what() << std::endl;
+            }
+        }
+    }
+
+    std::ifstream vendorIn(vendorListPath);
+    if (vendorIn) {
+        try {
+            nlohmann::json vendors;
+            vendorIn >> vendors;
+            for (auto& v : vendors) {
+                config.vendorsList.push_back(v.get<std::string>());
+            }
+        } catch (const nlohmann::json::exception& e) {
+            std::cerr << "Failed to parse vendor list JSON: " << e.what() << std::endl;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!document.is_object()) document = nlohmann::json::object();
+    m_document = std::move(document);
+    m_dirty = false;
+
+    return config;
+}
+
+void ConfigService::Update(const Config::AppConfig& config) {
+    nlohmann::json lastOpenedProject = config.lastOpenedProject;
+    nlohmann::json savedProjects = config.savedProjects;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_appConfigPath.empty()) return;
+
+        auto unchanged = [&](const char* key, const nlohmann::json& value) {
+            auto it = m_document.find(key);
+            return it != m_document.end() && *it == value;
+        };
+        if (unchanged("lastOpenedProject", lastOpenedProject) && unchanged("savedProjects", savedProjects)) {
+            return;
+        }
+
+        m_document["lastOpenedProject"] = std::move(lastOpenedProject);
+        m_document["savedProjects"] = std::move(savedProjects);
+        m_dirty = true;
+        m_flushDeadline = std::chrono::steady_clock::now() + m_debounce;
+    }
+    m_condition.notify_one();
+}
+
+void ConfigService::Flush() {
+    WritePending();
+}
+
+void ConfigService::FlushLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stop) {
+        m_condition.wait(lock, [this] { return m_stop || m_dirty; });
+
+        // Each Update() pushes the deadline back, so bursts collapse into one write
+        while (!m_stop && std::chrono::steady_clock::now() < m_flushDeadline) {
+            m_condition.wait_until(lock, m_flushDeadline);
+        }
+        if (m_stop) break;
+
+        lock.unlock();
+        WritePending();
+        lock.lock();
+    }
+}
+
+void ConfigService::WritePending() {
+    std::lock_guard<std::mutex> writeLock(m_writeMutex);
+
+    nlohmann::json document;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_dirty) return;
+        document = m_document;
+        m_dirty = false;
+    }
+
+    if (!WriteDocument(document)) {
+        // Retry on the next debounce tick rather than spinning on a bad path
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_dirty = true;
+        m_flushDeadline = std::chrono::steady_clock::now() + m_debounce;
+    }
+}
+
+bool ConfigService::WriteDocument(const nlohmann::json& document) {
+    // Write to a sibling file and swap it in so a crash never leaves a truncated app.json
+    fs::path tmpPath = m_appConfigPath;
+    tmpPath += ".tmp";
+
+    {
+        std::ofstream out(tmpPath, std::ios::out | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Failed to open " << tmpPath << " for writing!" << std::endl;
+            return false;
+        }
+        out << document.dump(4);
+        if (!out.good()) {
+            std::cerr << "Failed to write " << tmpPath << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tmpPath, m_appConfigPath, ec);
+    if (ec) {
+        std::cerr << "Failed to replace " << m_appConfigPath << " (" << ec.message() << ")" << std::endl;
+        return false;
+    }
+    return true;
+}
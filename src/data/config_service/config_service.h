@@ -0,0 +1,56 @@
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+#include <nlohmann/json.hpp>
+
+#include "../../core/config.h"
+
+namespace fs = std::filesystem;
+
+// Keeps app.json and vendorList.json parsed in memory for the lifetime of the
+// application. Updates are diffed against the in-memory document and only real
+// changes are written, debounced, by a single background flush thread.
+class ConfigService {
+private:
+    fs::path m_appConfigPath;
+    fs::path m_vendorListPath;
+
+    // Full app.json document; keys we don't model are preserved on write
+    nlohmann::json m_document = nlohmann::json::object();
+    bool m_dirty = false;
+
+    std::chrono::milliseconds m_debounce;
+    std::chrono::steady_clock::time_point m_flushDeadline;
+
+    std::mutex m_mutex;
+    std::mutex m_writeMutex;    // serialises background and explicit flushes
+    std::condition_variable m_condition;
+    std::thread m_flushThread;
+    bool m_stop = false;
+
+    void FlushLoop();
+    void WritePending();
+    bool WriteDocument(const nlohmann::json& document);
+
+public:
+    explicit ConfigService(std::chrono::milliseconds debounce = std::chrono::milliseconds(500));
+    ~ConfigService();
+
+    ConfigService(const ConfigService&) = delete;
+    ConfigService& operator=(const ConfigService&) = delete;
+
+    // Parses both files once; later calls to Update() are compared against this state
+    Config::AppConfig Load(const fs::path& appConfigPath, const fs::path& vendorListPath);
+
+    // Schedules a write if the persisted fields of config differ from the cached document
+    void Update(const Config::AppConfig& config);
+
+    // Writes any pending change immediately (used on shutdown)
+    void Flush();
+};
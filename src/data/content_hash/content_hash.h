@@ -0,0 +1,12 @@
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// XXH64 over a byte range. Fast and stable across platforms; not cryptographic.
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 0);
+
+// Lower-case, zero-padded hex of a 64-bit hash
+std::string HashToHex(uint64_t hash);
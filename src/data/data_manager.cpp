@@ -1,6 +1,9 @@
 
 #include "data_manager.h"
 #include "../file_utils/file_utils.h"
+#include "../core/trace/trace.h"
+#include "decimal_parser/decimal_parser.h"
+#include "histogram_cache/histogram_cache.h"
 
 #include <nlohmann/json.hpp>
 
@@ -9,11 +12,15 @@
 #include <iomanip>
 #include <iostream>
 #include <fstream>
+#include <cstring>
+#include <string_view>
 
 using json = nlohmann::json;
 
 bool DataManager::Initialize(Config::AppConfig* config, Project* currentProject) {
-    *config = loadAppConfig("../../data/app.json");
+    *config = configService.Load(Config::APP_CONFIG_FILE, Config::VENDOR_LIST_FILE);
+    ToolConfig::SetCurrent(config->tools);
+    ProcessExecutor::Shared().SetMaxConcurrent(config->toolJobs > 0 ? config->toolJobs : ProcessExecutor::DefaultConcurrency());
     if (!config->lastOpenedProject.path.empty()) {
         *currentProject = LoadProject(config->lastOpenedProject.path + "\\project.json");
     }
@@ -21,62 +28,12 @@ bool DataManager::Initialize(Config::AppConfig* config, Project* currentProject)
     return true;
 }
 
-Config::AppConfig DataManager::loadAppConfig(const std::string& relativePath) {
-    Config::AppConfig config;
-
-    if (relativePath.empty()) {
-        std::cerr << "No config file path provided." << std::endl;
-        return config;
-    }
-
-    // Resolve relative path against current working directory
-    fs::path fullPath = fs::current_path() / relativePath;
-
-    if (!fs::exists(fullPath)) {
-        std::cerr << "Config file does not exist: " << fullPath << std::endl;
-        return config;
-    }
-
-    // Open and parse JSON
-    std::ifstream in(fullPath);
-    if (!in.is_open()) {
-        std::cerr << "Failed to open config file: " << fullPath << std::endl;
-        return config;
-    }
-
-    try {
-        nlohmann::json j;
-        in >> j;
-        config = j.get<Config::AppConfig>();
-    } catch (const nlohmann::json::exception& e) {
-        std::cerr << "Failed to parse config JSON: " << e.what() << std::endl;
-    }
-
-    config.vendorsList = GetVendorList();
-
-    return config;
+void DataManager::saveAppConfig(const Config::AppConfig& config) {
+    configService.Update(config);
 }
 
-void DataManager::saveAppConfig(const std::string& filePath, const Config::AppConfig& config) {
-    // Read existing JSON
-    std::ifstream in(filePath);
-    nlohmann::json j;
-    if (in.is_open()) {
-        in >> j;
-        in.close();
-    }
-
-    // Update only the app config fields
-    j["lastOpenedProject"] = config.lastOpenedProject;
-    j["savedProjects"] = config.savedProjects;
-
-    // Write back
-    std::ofstream out(filePath);
-    if (!out.is_open()) {
-        std::cerr << "Failed to open " << filePath << " for writing!" << std::endl;
-        return;
-    }
-    out << j.dump(4);
+void DataManager::FlushAppConfig() {
+    configService.Flush();
 }
 
 fs::path DataManager::NewProject(const std::string& vendor, const std::string& repo, const std::string& projectName) {
@@ -102,6 +59,7 @@ fs::path DataManager::NewProject(const std::string& vendor, const std::string& r
 }
 
 Project DataManager::LoadProject(const std::string& filename) {
+    TRACE_SCOPE("project.load");
     Project proj;
 
     fs::path fullPath = fs::absolute(filename);
@@ -178,7 +136,7 @@ Project DataManager::LoadProject(const std::string& filename) {
                             std::string content(size, '\0');
                             std::ifstream in(statisticData.nonIidResultFilePath);
                             in.read(&content[0], size);
-                            statisticData.nonIidResult = content;
+                            statisticData.nonIidResult = std::move(content);
                         }
                     }
 
@@ -192,7 +150,7 @@ Project DataManager::LoadProject(const std::string& filename) {
                             std::string content(size, '\0');
                             std::ifstream in(statisticData.restartResultFilePath);
                             in.read(&content[0], size);
-                            statisticData.restartResult = content;
+                            statisticData.restartResult = std::move(content);
                         }
                     }
                 }
@@ -209,14 +167,27 @@ Project DataManager::LoadProject(const std::string& filename) {
                         mainHist.maxValue = mhJson.value("maxValue", 0u);
                         mainHist.binWidth  = mhJson.value("binWidth", 1.0);
 
-                        if (mhJson.contains("computedBins") && mhJson["computedBins"].is_array()) {
-                            mainHist.binCounts.fill(0);
-                            size_t i = 0;
-                            for (auto& bin : mhJson["computedBins"]) {
-                                if (bin.is_number_integer() && i < mainHist.binCounts.size()) {
-                                    mainHist.binCounts[i++] = bin.get<int>();
-                                }
+                        // rawBins are exact counts; older projects only stored the smoothed
+                        // computedBins, which are shown as they are until the file is reprocessed
+                        const bool hasRawBins = mhJson.contains("rawBins");
+                        const char* binsKey = hasRawBins ? "rawBins" : "computedBins";
+                        if (mhJson.contains(binsKey) && mhJson[binsKey].is_array()) {
+                            std::vector<int> bins;
+                            bins.reserve(mhJson[binsKey].size());
+                            for (auto& bin : mhJson[binsKey]) {
+                                bins.push_back(bin.is_number_integer() ? bin.get<int>() : 0);
                             }
+                            mainHist.binCounts = std::move(bins);
+                        }
+                        mainHist.requestedBinCount = mhJson.value("requestedBinCount", 0);
+                        // The value index comes from the histogram cache later, off the UI thread (LoadValueIndex)
+                        if (hasRawBins) {
+                            mainHist.smoothingKernel = parseSmoothingKernel(mhJson.value("smoothingKernel", ""))
+                                .value_or(SmoothingKernel::Gaussian);
+                            mainHist.smoothingSigma = mhJson.value("smoothingSigma", mainHist.smoothingSigma);
+                            smoothHistogram(mainHist);
+                        } else {
+                            mainHist.smoothedCounts = std::vector<double>(mainHist.binCounts.begin(), mainHist.binCounts.end());
                         }
 
                         if (mhJson.contains("nonIidResults") && mhJson["nonIidResults"].is_object()) {
@@ -279,8 +250,9 @@ Project DataManager::LoadProject(const std::string& filename) {
     return proj;
 }
 
-void DataManager::SaveProject(Project& project, Config::AppConfig& appConfig) {
-    if (project.name.empty() || project.path.empty()) return;
+bool DataManager::WriteProjectFiles(Project& project) {
+    TRACE_SCOPE("project.save");
+    if (project.name.empty() || project.path.empty()) return false;
 
     UpdateOEsForProject(project);
 
@@ -309,26 +281,22 @@ void DataManager::SaveProject(Project& project, Config::AppConfig& appConfig) {
     std::ofstream out(projectJsonPath);
     if (!out.is_open()) {
         std::cerr << "Failed to open project file for writing: " << projectJsonPath << std::endl;
-        return;
+        return false;
     }
     out << projectJson.dump(4);
     out.close();
 
-    // Update savedProjects in appConfig if not already present
-    auto it = std::find_if(
-        appConfig.savedProjects.begin(),
-        appConfig.savedProjects.end(),
-        [&](const Project& p) { return p.path == project.path; }
-    );
+    return true;
+}
 
-    if (it == appConfig.savedProjects.end()) {
-        appConfig.savedProjects.push_back(project);
-    } else {
-        *it = project; // ensure vendor/repo are up-to-date
-    }
+void DataManager::SaveProject(Project& project, Config::AppConfig& appConfig) {
+    if (!WriteProjectFiles(project)) return;
+
+    // Update savedProjects in appConfig (adds it, or refreshes vendor/repo/OE count)
+    appConfig.savedProjects.Upsert(project);
 
     // Persist app.json
-    saveAppConfig("../../data/app.json", appConfig);
+    saveAppConfig(appConfig);
 }
 
 void DataManager::AddOEToProject(Project& project, const std::string& oeName, Config::AppConfig& appConfig) {
@@ -376,7 +344,7 @@ void DataManager::AddOEToProject(Project& project, const std::string& oeName, Co
     out.close();
 
     // Update in-memory Project object
-    project.operationalEnvironments.push_back(newOE);
+    project.operationalEnvironments.push_back(std::move(newOE));
 
     // Create OE directory
     fs::path oeDir = projectDir / "OE" / oeName;
@@ -398,19 +366,11 @@ void DataManager::AddOEToProject(Project& project, const std::string& oeName, Co
         oeOut << oeJson.dump(4);
     }
 
-    // Optionally update appConfig.savedProjects if project not present
-    auto it = std::find_if(
-        appConfig.savedProjects.begin(),
-        appConfig.savedProjects.end(),
-        [&](const Project& p) { return p.path == project.path; }
-    );
-
-    if (it == appConfig.savedProjects.end()) {
-        appConfig.savedProjects.push_back(project);
-    }
+    // Update appConfig.savedProjects with the new OE count
+    appConfig.savedProjects.Upsert(project);
 
     // Persist app config
-    saveAppConfig("../../data/app.json", appConfig);
+    saveAppConfig(appConfig);
 }
 
 void DataManager::DeleteOE(Project& project, int oeIndex, Config::AppConfig& appConfig) {
@@ -480,32 +440,9 @@ void DataManager::DeleteOE(Project& project, int oeIndex, Config::AppConfig& app
     }
 
     // Persist app config (make sure project is still in savedProjects)
-    auto it = std::find_if(
-        appConfig.savedProjects.begin(),
-        appConfig.savedProjects.end(),
-        [&](const Project& p) { return p.path == project.path; }
-    );
-
-    if (it == appConfig.savedProjects.end()) {
-        appConfig.savedProjects.push_back(project);
-    } else {
-        *it = project; // update existing
-    }
+    appConfig.savedProjects.Upsert(project);
 
-    saveAppConfig("../../data/app.json", appConfig);
-}
-
-std::vector<std::string> DataManager::GetVendorList() {
-    std::vector<std::string> vendors;
-    std::ifstream in("../../data/vendorList.json");
-    if (in) {
-        nlohmann::json j;
-        in >> j;
-        for (auto& v : j) {
-            vendors.push_back(v.get<std::string>());
-        }
-    }
-    return vendors;
+    saveAppConfig(appConfig);
 }
 
 void DataManager::UpdateOEsForProject(Project& project) {
@@ -636,7 +573,10 @@ void DataManager::UpdateOEsForProject(Project& project) {
             mhJson["minValue"] = mainHist.minValue;
             mhJson["maxValue"] = mainHist.maxValue;
             mhJson["binWidth"] = mainHist.binWidth;
-            mhJson["computedBins"] = mainHist.binCounts;
+            mhJson["rawBins"] = mainHist.binCounts.values();
+            if (mainHist.requestedBinCount > 0) mhJson["requestedBinCount"] = mainHist.requestedBinCount;
+            mhJson["smoothingKernel"] = smoothingKernelName(mainHist.smoothingKernel);
+            mhJson["smoothingSigma"] = mainHist.smoothingSigma;
 
             if (mainHist.nonIidParsedResults.minEntropy != 0.0f) {
                 const auto& res = mainHist.nonIidParsedResults;
@@ -683,20 +623,39 @@ void DataManager::UpdateOEsForProject(Project& project) {
 }
 
 // Heuristic
-void DataManager::processHistogramForProject(Project& project, int oeIndex, ThreadPool& pool, NotificationCallback notify) {
-    auto* oePtr = &project.operationalEnvironments[oeIndex];
-
-    pool.Enqueue([oePtr, notify]() {
-        if (notify) notify("Processing histogram...", 5.0f, ImVec4(0.1f, 0.7f, 1.0f, 1.0f));
+void DataManager::processHistogramForProject(Project& project, int oeIndex, NotificationCallback notify) {
+    auto& mainHist = project.operationalEnvironments[oeIndex].heuristicData.mainHistogram;
+
+    if (notify) notify("Processing histogram...", 5.0f, ImVec4(0.1f, 0.7f, 1.0f, 1.0f));
+
+    auto filePath = mainHist.heuristicFilePath;
+    const auto binCount = static_cast<unsigned int>(std::max(0, mainHist.requestedBinCount));
+    // Unsaved projects have no cache directory yet, so they always recompute
+    HistogramSummary summary;
+    MainHistogram hist = project.path.empty()
+        ? computeHistogramFromFile(filePath, 0, binCount, &summary)
+        : HistogramCache(project.path).GetOrCompute(filePath, binCount, &summary);
+    hist.heuristicFilePath = filePath; // preserve
+    hist.convertedFilePath  = mainHist.convertedFilePath;   // preserve converted path
+    hist.subHists = std::move(mainHist.subHists);           // regions are in value space, still valid
+    hist.requestedBinCount = mainHist.requestedBinCount;
+    hist.valueIndex = std::move(summary.valueIndex);
+    // hist comes back smoothed with the defaults; redo it only for the user's own settings
+    if (hist.smoothingKernel != mainHist.smoothingKernel || hist.smoothingSigma != mainHist.smoothingSigma) {
+        hist.smoothingKernel = mainHist.smoothingKernel;
+        hist.smoothingSigma = mainHist.smoothingSigma;
+        smoothHistogram(hist);
+    }
+    mainHist = std::move(hist);
 
-        auto filePath = oePtr->heuristicData.mainHistogram.heuristicFilePath;
-        MainHistogram hist = computeHistogramFromFile(filePath);
-        hist.heuristicFilePath = filePath; // preserve
-        hist.convertedFilePath  = oePtr->heuristicData.mainHistogram.convertedFilePath;   // preserve converted path
-        oePtr->heuristicData.mainHistogram = std::move(hist);
+    if (notify) notify("Histogram processing complete!", 5.0f, ImVec4(0.2f, 1.0f, 0.2f, 1.0f));
+}
 
-        if (notify) notify("Histogram processing complete!", 5.0f, ImVec4(0.2f, 1.0f, 0.2f, 1.0f));
-    });
+std::shared_ptr<const ValueIndex> DataManager::LoadValueIndex(const fs::path& projectPath, const fs::path& sampleFile, int requestedBinCount) {
+    if (projectPath.empty() || sampleFile.empty()) return nullptr;
+    const auto binCount = static_cast<unsigned int>(std::max(0, requestedBinCount));
+    auto key = HistogramCache::KeyFor(sampleFile, binCount);
+    return key ? HistogramCache(projectPath).LookupValueIndex(*key) : nullptr;
 }
 
 bool DataManager::ConvertDecimalFile(
@@ -704,34 +663,57 @@ bool DataManager::ConvertDecimalFile(
     std::filesystem::path& outBinaryFilePath,
     std::optional<double> minVal,
     std::optional<double> maxVal,
-    int regionIndex)
+    int regionIndex,
+    ConvertProgress* progress)
 {
-    std::ifstream inFile(inputFilePath);
+    TRACE_SCOPE("convert");
+    std::ifstream inFile(inputFilePath, std::ios::binary);
     if (!inFile.is_open()) return false;
 
     std::vector<uint8_t> symbols;
-    std::string line;
-
-    while (std::getline(inFile, line)) {
-        try {
-            // Parse only the first number (before the space)
-            size_t spacePos = line.find(' ');
-            std::string firstNum = (spacePos != std::string::npos) 
-                                   ? line.substr(0, spacePos) 
-                                   : line;
-            
-            uint64_t val = std::stoull(firstNum);  // Convert directly to uint64_t
-            
+
+    // Read in fixed blocks and parse up to the last complete line; the partial
+    // line is carried over to the front of the next block
+    constexpr size_t blockSize = 16 << 20;
+    std::vector<char> buffer(blockSize);
+    std::vector<uint64_t> values;
+    size_t carried = 0;
+
+    for (;;) {
+        inFile.read(buffer.data() + carried, static_cast<std::streamsize>(buffer.size() - carried));
+        size_t filled = carried + static_cast<size_t>(inFile.gcount());
+        bool last = !inFile;
+        if (progress) {
+            progress->bytesRead.fetch_add(static_cast<uint64_t>(inFile.gcount()), std::memory_order_relaxed);
+            if (progress->Cancelled()) return false;
+        }
+        if (filled == 0) break;
+
+        size_t parseEnd = filled;
+        if (!last) {
+            size_t lastNewline = std::string_view(buffer.data(), filled).rfind('\n');
+            if (lastNewline == std::string_view::npos) {
+                // Line longer than the block: grow and keep reading
+                carried = filled;
+                buffer.resize(buffer.size() * 2);
+                continue;
+            }
+            parseEnd = lastNewline + 1;
+        }
+
+        values.clear();
+        DecimalParser::ParseLines(buffer.data(), buffer.data() + parseEnd, values);
+        for (uint64_t val : values) {
             // Optional: apply range filtering if needed
             if ((minVal && val < minVal.value()) || (maxVal && val > maxVal.value())) {
                 continue;
             }
-
-            uint8_t symbol = static_cast<uint8_t>(val & 0xFF);  // Mask LSB 8-bits
-            symbols.push_back(symbol);
-        } catch (...) {
-            continue; // skip invalid lines
+            symbols.push_back(static_cast<uint8_t>(val & 0xFF));  // Mask LSB 8-bits
         }
+
+        if (last) break;
+        carried = filled - parseEnd;
+        std::memmove(buffer.data(), buffer.data() + parseEnd, carried);
     }
 
     if (symbols.empty()) return false;
@@ -11,7 +11,9 @@
 #include "models.h"
 #include "../core/config.h"
 #include "../core/thread_pool/thread_pool.h"
+#include "../core/conversion_job/conversion_job.h"
 #include "histogram/histogram.h"
+#include "config_service/config_service.h"
 
 namespace fs = std::filesystem;
 
@@ -20,9 +22,9 @@ using NotificationCallback = std::function<void(const std::string&, float, ImVec
 class DataManager {
 private:    
     std::string current_project_file;
+    ConfigService configService;
 
     // Helpers
-    std::vector<std::string> GetVendorList();
     void UpdateOEsForProject(Project& project);
 
 public:
@@ -33,21 +35,27 @@ public:
     bool Initialize(Config::AppConfig* config, Project* currentProjects);
 
     // Config
-    Config::AppConfig loadAppConfig(const std::string& filePath);
-    void saveAppConfig(const std::string& filePath, const Config::AppConfig& config);
+    void saveAppConfig(const Config::AppConfig& config);
+    void FlushAppConfig();
     
     // Project management
     fs::path NewProject(const std::string& vendor, const std::string& repo, const std::string& projectName);
     Project LoadProject(const std::string& relativePath);
     void SaveProject(Project& project, Config::AppConfig& appConfig);
+    bool WriteProjectFiles(Project& project); // project.json + oe.json only, leaves app.json alone
     void AddOEToProject(Project& project, const std::string& oeName, Config::AppConfig& appConfig);
     void DeleteOE(Project& project, int oeIndex, Config::AppConfig& appConfig);
 
     // Heuristic
-    void processHistogramForProject(Project& project, int oeIndex, ThreadPool& pool, NotificationCallback notify);
+    void processHistogramForProject(Project& project, int oeIndex, NotificationCallback notify); // runs on the caller's thread
+    // The exact per-value counts of a processed main histogram, from the project's
+    // histogram cache if its sample file is unchanged; reads and parses the cache
+    // entry, so keep it off the UI thread. Null when there is none.
+    std::shared_ptr<const ValueIndex> LoadValueIndex(const fs::path& projectPath, const fs::path& sampleFile, int requestedBinCount);
     bool ConvertDecimalFile(const std::filesystem::path& inputFilePath,
                             std::filesystem::path& outBinaryFilePath,
                             std::optional<double> minVal = std::nullopt,
                             std::optional<double> maxVal = std::nullopt,
-                            int regionIndex = 0);
+                            int regionIndex = 0,
+                            ConvertProgress* progress = nullptr); // false when cancelled
 };
\ No newline at end of file
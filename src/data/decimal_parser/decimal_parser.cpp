@@ -0,0 +1,276 @@
+
+#include "decimal_parser.h"
+
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <climits>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define DECIMAL_PARSER_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define DECIMAL_PARSER_TARGET(isa)
+#else
+#define DECIMAL_PARSER_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+namespace DecimalParser {
+    namespace {
+        inline const char* SkipBlanks(const char* p, const char* lineEnd) {
+            while (p < lineEnd && (*p == ' ' || *p == '\t')) ++p;
+            return p;
+        }
+
+        // Reference semantics, also used for long digit runs and near the buffer end
+        template<typename T>
+        inline bool ParseLineScalar(const char* p, const char* lineEnd, T& value) {
+            p = SkipBlanks(p, lineEnd);
+            return std::from_chars(p, lineEnd, value).ec == std::errc{};
+        }
+
+        template<typename T>
+        inline bool FitMagnitude(uint64_t magnitude, bool negative, T& value) {
+            if constexpr (std::is_signed_v<T>) {
+                const uint64_t limit = static_cast<uint64_t>(std::numeric_limits<T>::max()) + (negative ? 1 : 0);
+                if (magnitude > limit) return false;
+                value = negative ? static_cast<T>(-static_cast<int64_t>(magnitude)) : static_cast<T>(magnitude);
+                return true;
+            } else {
+                if (negative || magnitude > std::numeric_limits<T>::max()) return false;
+                value = static_cast<T>(magnitude);
+                return true;
+            }
+        }
+
+        template<typename T>
+        size_t ParseLinesScalar(const char* begin, const char* end, std::vector<T>& out) {
+            size_t rejected = 0;
+            const char* current = begin;
+            while (current < end) {
+                const char* lineEnd = FindNewline(current, end);
+                if (current < lineEnd) {
+                    T value;
+                    if (ParseLineScalar(current, lineEnd, value)) out.push_back(value);
+                    else ++rejected;
+                }
+                current = lineEnd + 1;
+            }
+            return rejected;
+        }
+
+#ifdef DECIMAL_PARSER_X86
+        // Digits (already minus '0') right-aligned into 16 lanes: load at kAlign + length
+        alignas(16) constexpr uint8_t kAlign[32] = {
+            0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+            0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+        };
+
+        // Decodes the digit run at p (needs 16 readable bytes). Returns its length,
+        // or 16 when the run may be longer than the SIMD path handles.
+        DECIMAL_PARSER_TARGET("sse4.2")
+        inline int DecodeDigitsSse(const char* p, uint64_t& magnitude) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            const __m128i digits = _mm_sub_epi8(chunk, _mm_set1_epi8('0'));
+            const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+            const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(isDigit));
+            const int length = std::countr_one(mask);
+            if (length == 0 || length == 16) return length;
+
+            const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kAlign + length));
+            const __m128i aligned = _mm_shuffle_epi8(digits, shuffle);
+
+            // 16 x 1 digit -> 8 x 2 -> 4 x 4 -> 2 x 8
+            const __m128i pairs = _mm_maddubs_epi16(aligned, _mm_set1_epi16(0x010A));
+            const __m128i quads = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00010064));
+            const __m128i packed = _mm_packus_epi32(quads, quads);
+            const __m128i octets = _mm_madd_epi16(packed, _mm_set1_epi32(0x00012710));
+
+            const uint64_t high = static_cast<uint32_t>(_mm_cvtsi128_si32(octets));
+            const uint64_t low = static_cast<uint32_t>(_mm_extract_epi32(octets, 1));
+            magnitude = high * 100000000ULL + low;
+            return length;
+        }
+
+        template<typename T>
+        DECIMAL_PARSER_TARGET("sse4.2")
+        inline bool ParseLineSse(const char* lineStart, const char* lineEnd, const char* bufferEnd, T& value) {
+            const char* p = SkipBlanks(lineStart, lineEnd);
+            bool negative = false;
+            if constexpr (std::is_signed_v<T>) {
+                if (p < lineEnd && *p == '-') {
+                    negative = true;
+                    ++p;
+                }
+            }
+            if (bufferEnd - p < 16) return ParseLineScalar(lineStart, lineEnd, value);
+
+            uint64_t magnitude = 0;
+            int length = DecodeDigitsSse(p, magnitude);
+            if (length == 0) return false;
+            if (length == 16) return ParseLineScalar(lineStart, lineEnd, value);
+            return FitMagnitude(magnitude, negative, value);
+        }
+
+        // Parses every line ending at a set bit of mask (bit i = block[i] is '\n')
+        template<typename T>
+        DECIMAL_PARSER_TARGET("sse4.2")
+        inline void ConsumeLineEnds(uint64_t mask, const char* block, const char* end,
+                                    const char*& lineStart, std::vector<T>& out, size_t& rejected)
+        {
+            while (mask) {
+                const char* lineEnd = block + std::countr_zero(mask);
+                mask &= mask - 1;
+                if (lineStart < lineEnd) {
+                    T value;
+                    if (ParseLineSse(lineStart, lineEnd, end, value)) out.push_back(value);
+                    else ++rejected;
+                }
+                lineStart = lineEnd + 1;
+            }
+        }
+
+        template<typename T>
+        DECIMAL_PARSER_TARGET("sse4.2")
+        size_t FinishTail(const char* block, const char* end, const char* lineStart, std::vector<T>& out, size_t rejected) {
+            uint64_t mask = 0;
+            for (const char* p = block; p < end; ++p) {
+                if (*p == '\n') mask |= 1ULL << (p - block);
+            }
+            ConsumeLineEnds(mask, block, end, lineStart, out, rejected);
+
+            // Last line without a trailing newline
+            if (lineStart < end) {
+                T value;
+                if (ParseLineScalar(lineStart, end, value)) out.push_back(value);
+                else ++rejected;
+            }
+            return rejected;
+        }
+
+        template<typename T>
+        DECIMAL_PARSER_TARGET("sse4.2")
+        size_t ParseLinesSse42(const char* begin, const char* end, std::vector<T>& out) {
+            size_t rejected = 0;
+            const char* lineStart = begin;
+            const char* block = begin;
+            const __m128i newline = _mm_set1_epi8('\n');
+
+            for (; end - block >= 64; block += 64) {
+                uint64_t mask = 0;
+                for (int i = 0; i < 4; ++i) {
+                    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i * 16));
+                    const uint64_t lane = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, newline)));
+                    mask |= lane << (i * 16);
+                }
+                ConsumeLineEnds(mask, block, end, lineStart, out, rejected);
+            }
+            return FinishTail(block, end, lineStart, out, rejected);
+        }
+
+        template<typename T>
+        DECIMAL_PARSER_TARGET("avx2")
+        size_t ParseLinesAvx2(const char* begin, const char* end, std::vector<T>& out) {
+            size_t rejected = 0;
+            const char* lineStart = begin;
+            const char* block = begin;
+            const __m256i newline = _mm256_set1_epi8('\n');
+
+            for (; end - block >= 64; block += 64) {
+                const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+                const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+                const uint64_t lowMask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, newline)));
+                const uint64_t highMask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, newline)));
+                ConsumeLineEnds(lowMask | (highMask << 32), block, end, lineStart, out, rejected);
+            }
+            return FinishTail(block, end, lineStart, out, rejected);
+        }
+
+        bool CpuSupports(Isa isa) {
+            if (isa == Isa::Scalar) return true;
+#if defined(_MSC_VER) && !defined(__clang__)
+            int info[4];
+            __cpuid(info, 1);
+            const bool sse42 = (info[2] & (1 << 20)) != 0;
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            if (isa == Isa::Sse42) return sse42;
+            if (!sse42 || !osxsave || (_xgetbv(0) & 0x6) != 0x6) return false;
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            __builtin_cpu_init();
+            if (isa == Isa::Sse42) return __builtin_cpu_supports("sse4.2");
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("sse4.2");
+#endif
+        }
+#else
+        bool CpuSupports(Isa isa) {
+            return isa == Isa::Scalar;
+        }
+#endif
+
+        std::atomic<Isa>& Active() {
+            static std::atomic<Isa> active{ DetectIsa() };
+            return active;
+        }
+
+        template<typename T>
+        size_t Dispatch(const char* begin, const char* end, std::vector<T>& out) {
+            if (begin >= end) return 0;
+            out.reserve(out.size() + static_cast<size_t>(end - begin) / 8); // rough estimate
+
+            switch (Active().load(std::memory_order_relaxed)) {
+#ifdef DECIMAL_PARSER_X86
+                case Isa::Avx2: return ParseLinesAvx2(begin, end, out);
+                case Isa::Sse42: return ParseLinesSse42(begin, end, out);
+#endif
+                default: return ParseLinesScalar(begin, end, out);
+            }
+        }
+    }
+
+    Isa DetectIsa() {
+        if (CpuSupports(Isa::Avx2)) return Isa::Avx2;
+        if (CpuSupports(Isa::Sse42)) return Isa::Sse42;
+        return Isa::Scalar;
+    }
+
+    Isa ActiveIsa() {
+        return Active().load(std::memory_order_relaxed);
+    }
+
+    bool SetIsa(Isa isa) {
+        if (!CpuSupports(isa)) return false;
+        Active().store(isa, std::memory_order_relaxed);
+        return true;
+    }
+
+    const char* IsaName(Isa isa) {
+        switch (isa) {
+            case Isa::Scalar: return "scalar";
+            case Isa::Sse42: return "sse4.2";
+            case Isa::Avx2: return "avx2";
+        }
+        return "unknown";
+    }
+
+    const char* FindNewline(const char* begin, const char* end) {
+        if (begin >= end) return end;
+        // memchr is already vectorised by every C runtime we ship on
+        const void* found = std::memchr(begin, '\n', static_cast<size_t>(end - begin));
+        return found ? static_cast<const char*>(found) : end;
+    }
+
+    size_t ParseLines(const char* begin, const char* end, std::vector<int>& out) {
+        return Dispatch(begin, end, out);
+    }
+
+    size_t ParseLines(const char* begin, const char* end, std::vector<uint64_t>& out) {
+        return Dispatch(begin, end, out);
+    }
+}
@@ -0,0 +1,34 @@
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Bulk parser for newline-delimited decimal sample files.
+//
+// Each line contributes its leading integer; anything after the digits (a
+// second column, a trailing '\r') is ignored, and lines without a leading
+// integer are skipped. Line ends are located 32/64 bytes at a time and short
+// digit runs are decoded with SIMD multiply-adds. The instruction set is picked
+// once at runtime (AVX2, SSE4.2, or a portable scalar path).
+namespace DecimalParser {
+    enum class Isa { Scalar, Sse42, Avx2 };
+
+    // Best instruction set this CPU supports
+    Isa DetectIsa();
+    // Instruction set currently used by ParseLines
+    Isa ActiveIsa();
+    // Forces a specific path (benchmarks); fails if the CPU does not support it
+    bool SetIsa(Isa isa);
+    const char* IsaName(Isa isa);
+
+    // First '\n' in [begin, end), or end
+    const char* FindNewline(const char* begin, const char* end);
+
+    // Appends the leading integer of every line in [begin, end) to out.
+    // Values that do not fit the element type are skipped. Returns the number
+    // of non-empty lines skipped.
+    size_t ParseLines(const char* begin, const char* end, std::vector<int>& out);
+    size_t ParseLines(const char* begin, const char* end, std::vector<uint64_t>& out);
+}
@@ -3,89 +3,60 @@
 #include <fstream>
 #include <iostream>
 #include <string>
-#include <algorithm>
-#include <regex>
+#include <iterator>
 
+#include "find_first_passing_decimation.h"
 #include "../../file_utils/file_utils.h"
 
-std::string parsePerlOutputString(const std::string& output) {
-    std::istringstream stream(output);
-    std::string line;
-    bool foundRate = false;
-    int rate = 0;
-    bool noDecimationRequired = false;
-    bool maxDecimationFails = false;
-    bool moreDataRequired = false;
-
-    while (std::getline(stream, line)) {
-        if (line.find("The first passing decimation rate is") != std::string::npos) {
-            size_t pos = line.find("The first passing decimation rate is");
-            if (pos != std::string::npos) {
-                std::string sub = line.substr(pos + 35);
-                std::istringstream numberStream(sub);
-                numberStream >> rate;
-                if (numberStream) {
-                    foundRate = true;
-                }
-            }
-        } else if (line.find("Invariant failed: No decimation passes IID testing. No decimation required to test using the essentially IID approach.") != std::string::npos) {
-            noDecimationRequired = true;
-        } else if (line.find("Invariant failed: Max decimation fails IID testing") != std::string::npos) {
-            maxDecimationFails = true;
-        } else if (line.find("More data is required to test with the provided decimation level.") != std::string::npos) {
-            moreDataRequired = true;
-        }
-    }
-
-    if (foundRate) {
-        return "Passed: Found passing decimation rate: " + std::to_string(rate);
-    } else if (noDecimationRequired) {
-        return "Failed: No decimation required to test using the essentially IID approach.";
-    } else if (maxDecimationFails) {
-        return "Failed: Proceed with the non-decimated data using empirical approach.";
-    } else if (moreDataRequired) {
-        return "Error: More data is required to test with the provided decimation level.";
-    } else {
-        return "Decimation result could not be determined";
-    }
-}
-
 static std::string getScriptVersion() {
-    std::regex version_pattern(
-        "# find-first-passing-decimation\\.pl version (\\d+)\\.(\\d+)\\.(\\d+)"
-    );
-
-    auto winPath = std::filesystem::path("\\\\wsl$\\Ubuntu-24.04") / "home/user/tools/find-first-passing-decimation.pl";
-    std::ifstream in(winPath);
+    const ToolConfig tools = ToolConfig::Current();
+    auto scriptPath = tools.HostPath(tools.decimationScript);
+    std::ifstream in(scriptPath, std::ios::binary);
     if (!in) return "Unknown version!";
 
-    std::string line;
-    std::smatch match;
-
-    while (std::getline(in, line)) {
-        if (std::regex_search(line, match, version_pattern)) {
-            return match[1].str() + "." + match[2].str() + "." + match[3].str();
-        }
-    }
-
-    return "Unknown version";
+    const std::string script((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::string version = ParseDecimationScriptVersion(script);
+    return version.empty() ? "Unknown version" : version;
 }
 
-std::string findFirstPassingDecimation(const std::filesystem::path& filepath) {
+DecimationReport findFirstPassingDecimation(const std::filesystem::path& filepath, ProcessResult* run) {
     std::string output = "";
 
     // find the scripts version number
     std::string scriptVersion = getScriptVersion();
     output += "find-first-passing-decimation.pl version " + scriptVersion + "\n";
 
-    std::string linuxPath = toWslCommandPath(filepath);
-    std::string cmd = "wsl perl /home/user/tools/find-first-passing-decimation.pl " + linuxPath + " 24 2>&1";
+    const ToolConfig tools = ToolConfig::Current();
+    const auto argv = tools.Command(tools.perl, { tools.decimationScript, tools.ToolPath(filepath), "24" });
+
+    ProcessOptions options;
+    options.mergeStderr = true;
+    options.limits = tools.decimationLimits;
+    // perl buffers its own output whatever stdbuf says, so a quiet stretch
+    // says nothing about progress; only the wall and CPU limits apply
+    options.limits.idleSeconds = 0.0;
 
-    output += executeCommand(cmd);
-    std::string resultString = parsePerlOutputString(output);
-    
     std::filesystem::path logFile = filepath.parent_path() / "firstPassingDecimationResult.txt";
+
+    ProcessResult result;
+    try {
+        result = executeCommand(argv, options);
+    } catch (const ProcessError& e) {
+        writeStringToFile(output + e.PartialLog(), logFile);
+        throw;
+    }
+    output += result.output;
+    if (!result.Succeeded()) {
+        if (!output.empty() && output.back() != '\n') output += '\n';
+        output += result.StatusLine();
+    }
+    if (run) {
+        result.output.clear();
+        *run = std::move(result);
+    }
+    DecimationReport report = ParseDecimation(output);
+    
     writeStringToFile(output, logFile);
 
-    return resultString;
+    return report;
 }
\ No newline at end of file
@@ -1,6 +1,12 @@
 
 #pragma once
 
+#include "../../core/process_executor/process_executor.h"
+#include "../result_parser/result_parser.h"
+
 #include <filesystem>
 
-std::string findFirstPassingDecimation(const std::filesystem::path& filepath);
\ No newline at end of file
+// Runs the decimation script on filepath and returns its parsed output (see
+// DecimationReport::Summary for the line shown to the user); run, if given,
+// receives the perl process result without its output
+DecimationReport findFirstPassingDecimation(const std::filesystem::path& filepath, ProcessResult* run = nullptr);
\ No newline at end of file
@@ -1,45 +1,183 @@
 
 #include "histogram.h"
+#include "../../core/trace/trace.h"
+#include "../decimal_parser/decimal_parser.h"
 
 #include <algorithm>
 #include <fstream>
 #include <iostream>
-#include <charconv>
 #include <thread>
 #include <vector>
-#include <array>
+#include <cmath>
+#include <climits>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
 
 namespace fs = std::filesystem;
 
-// --- Helper functions ---
-inline bool parseInteger(const char* start, const char* end, int& value) {
-    auto result = std::from_chars(start, end, value);
-    return result.ec == std::errc{};
-}
+namespace {
+    constexpr size_t BIN_BLOCK = 256;     // indices mapped per batch
+    constexpr size_t BIN_REPLICAS = 4;    // copies per thread, breaks same-bin store chains
+    constexpr uint32_t MAX_BIN_COUNT = 1u << 16;
+    constexpr size_t PARSE_BLOCK = 1 << 20;     // text parsed per pass into the uint64_t scratch
+    constexpr size_t MAX_CACHED_KERNELS = 32;
+
+    // 64-byte unit of the per-thread accumulators, so neighbouring threads never share a line
+    struct alignas(64) CacheLine {
+        uint32_t counts[16];
+    };
+
+    // One slot past the last bin catches out-of-range values; rounded up to whole cache lines
+    size_t binStride(uint32_t binCount) {
+        return (binCount + 1 + 15) / 16 * 16;
+    }
 
-inline const char* findNextNewline(const char* start, const char* end) {
-    while (start < end && *start != '\n') ++start;
-    return start;
-}
+    // Maps values to bins with a 32x32->64 multiply and a shift (fixed point) instead
+    // of a double multiply, cast and clamp per sample. Map() is branch-free so the
+    // compiler vectorises it. Values outside [minVal, maxVal] map to binCount.
+    class BinMapper {
+    private:
+        uint32_t m_minValue;
+        uint32_t m_range;
+        uint32_t m_binCount;
+        uint32_t m_scale = 0;
+        int m_shift = 0;
+
+    public:
+        // binCount bins of width span / binCount starting at minVal
+        BinMapper(int minVal, int maxVal, uint32_t span, uint32_t binCount)
+            : m_minValue(static_cast<uint32_t>(minVal)),
+              m_range(static_cast<uint32_t>(maxVal) - static_cast<uint32_t>(minVal)),
+              m_binCount(binCount)
+        {
+            // Largest shift whose scale still fits 32 bits; rounding the scale up keeps
+            // exact bin boundaries for spans up to ~1M
+            const uint64_t bins = binCount;
+            for (int shift = 47; shift >= 0; --shift) {
+                uint64_t scale = (bins << shift) / span + 1;
+                if (scale <= UINT32_MAX) {
+                    m_scale = static_cast<uint32_t>(scale);
+                    m_shift = shift;
+                    break;
+                }
+            }
+        }
+
+        // FixedBins != 0 is a compile-time copy of the bin count for the common sizes
+        template<uint32_t FixedBins>
+        void Map(const int* values, size_t count, uint32_t* bins) const {
+            const uint32_t binCount = FixedBins ? FixedBins : m_binCount;
+            const uint32_t lastBin = binCount - 1;
+            for (size_t i = 0; i < count; ++i) {
+                const uint32_t offset = static_cast<uint32_t>(values[i]) - m_minValue;
+                const uint32_t bin = static_cast<uint32_t>((static_cast<uint64_t>(offset) * m_scale) >> m_shift);
+                bins[i] = offset <= m_range ? std::min(bin, lastBin) : binCount;
+            }
+        }
+    };
+
+    // Counts values into BIN_REPLICAS interleaved copies at counts[r * stride + bin]
+    template<uint32_t FixedBins>
+    void binValues(const std::vector<int>& values, const BinMapper& mapper, uint32_t* counts, size_t stride) {
+        if constexpr (FixedBins != 0) stride = (FixedBins + 1 + 15) / 16 * 16;
+
+        // Map a block of indices (vectorised), then scatter round-robin over the replicas
+        uint32_t bins[BIN_BLOCK];
+        for (size_t base = 0; base < values.size(); base += BIN_BLOCK) {
+            const size_t n = std::min(BIN_BLOCK, values.size() - base);
+            mapper.Map<FixedBins>(values.data() + base, n, bins);
+            for (size_t j = 0; j < n; ++j) counts[(j % BIN_REPLICAS) * stride + bins[j]]++;
+        }
+    }
+
+    using BinValuesFn = void (*)(const std::vector<int>&, const BinMapper&, uint32_t*, size_t);
+
+    BinValuesFn selectBinValues(uint32_t binCount) {
+        switch (binCount) {
+            case 256:  return binValues<256>;
+            case 512:  return binValues<512>;
+            case 1024: return binValues<1024>;
+            case 1500: return binValues<1500>;
+            case 2048: return binValues<2048>;
+            case 4096: return binValues<4096>;
+            default:   return binValues<0>;
+        }
+    }
+
+    // Full symmetric kernel (2 * radius + 1 taps), built once per (kernel, sigma) and shared.
+    // std::exp isn't constexpr on every toolchain we build with, so the table is filled lazily.
+    // Zooming the main plot asks for a new sigma per zoom level, so only the most recently
+    // used kernels are kept; callers hold their kernel while smoothing with it.
+    std::shared_ptr<const std::vector<double>> smoothingWeights(SmoothingKernel kernel, double sigma) {
+        struct CachedKernel {
+            std::shared_ptr<const std::vector<double>> weights;
+            uint64_t lastUsed = 0;
+        };
+        static std::mutex mutex;
+        static std::map<std::pair<SmoothingKernel, long>, CachedKernel> cache;
+        static uint64_t uses = 0;
+
+        const long key = std::max(1L, std::lround(sigma * 100.0));   // slider resolution
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = cache.find({ kernel, key });
+        if (found != cache.end()) {
+            found->second.lastUsed = ++uses;
+            return found->second.weights;
+        }
 
-void processChunk(const char* chunkStart, const char* chunkEnd, std::vector<int>& numbers) {
-    const char* current = chunkStart;
-    numbers.reserve((chunkEnd - chunkStart) / 8); // rough estimate
+        sigma = key / 100.0;
+        auto weights = std::make_shared<std::vector<double>>();
+        if (kernel == SmoothingKernel::Box) {
+            // A box of 2h+1 taps has variance h(h+1)/3; pick h closest to sigma
+            const int half = std::max(1, static_cast<int>(std::lround((std::sqrt(1.0 + 12.0 * sigma * sigma) - 1.0) / 2.0)));
+            weights->assign(2 * half + 1, 1.0);
+        } else {
+            const int radius = static_cast<int>(std::ceil(3 * sigma));
+            weights->resize(2 * radius + 1);
+            for (int j = -radius; j <= radius; ++j) (*weights)[j + radius] = std::exp(-0.5 * (j * j) / (sigma * sigma));
+        }
+
+        if (cache.size() >= MAX_CACHED_KERNELS) {
+            cache.erase(std::min_element(cache.begin(), cache.end(), [](const auto& a, const auto& b) {
+                return a.second.lastUsed < b.second.lastUsed;
+            }));
+        }
+        cache[{ kernel, key }] = { weights, ++uses };
+        return weights;
+    }
 
-    while (current < chunkEnd) {
-        const char* lineEnd = findNextNewline(current, chunkEnd);
-        if (current < lineEnd) {
-            int value;
-            if (parseInteger(current, lineEnd, value)) {
-                numbers.push_back(value);
+    // Appends samples too large for an int (all above any value already in the
+    // index) to it; the index stores values as int64_t, so larger ones are dropped
+    std::shared_ptr<const ValueIndex> AddWideValues(std::shared_ptr<const ValueIndex> index,
+                                                    const std::vector<std::vector<uint64_t>>& threadWide) {
+        std::vector<uint64_t> wide;
+        for (const auto& values : threadWide) wide.insert(wide.end(), values.begin(), values.end());
+        wide.erase(std::remove_if(wide.begin(), wide.end(),
+                                  [](uint64_t v) { return v > static_cast<uint64_t>(INT64_MAX); }), wide.end());
+        if (wide.empty()) return index;
+
+        std::sort(wide.begin(), wide.end());
+        std::vector<int64_t> values = index->Values();
+        std::vector<uint64_t> counts = index->Counts();
+        for (uint64_t v : wide) {
+            if (!values.empty() && values.back() == static_cast<int64_t>(v)) {
+                ++counts.back();
+            } else {
+                values.push_back(static_cast<int64_t>(v));
+                counts.push_back(1);
             }
         }
-        current = lineEnd + 1;
+        return ValueIndex::FromCounts(values, counts);
     }
 }
 
 // --- MainHistogram computation ---
-MainHistogram computeHistogramFromFile(const fs::path& filePath) {
+MainHistogram computeHistogramFromFile(const fs::path& filePath, unsigned int numThreads, unsigned int binCount,
+                                       HistogramSummary* summary)
+{
+    TRACE_SCOPE("histogram");
     MainHistogram hist;
 
     if (!fs::exists(filePath)) {
@@ -58,29 +196,48 @@ MainHistogram computeHistogramFromFile(const fs::path& filePath) {
     file.seekg(0, std::ios::beg);
 
     std::string fileContent(fileSize, '\0');
-    if (!file.read(fileContent.data(), fileSize)) {
-        std::cerr << "Failed to read file: " << filePath << "\n";
-        return hist;
+    {
+        TRACE_SCOPE("histogram.read");
+        if (!file.read(fileContent.data(), fileSize)) {
+            std::cerr << "Failed to read file: " << filePath << "\n";
+            return hist;
+        }
     }
 
     const char* data = fileContent.data();
     const char* dataEnd = data + fileSize;
 
-    const unsigned int numThreads = std::thread::hardware_concurrency();
+    if (numThreads == 0) numThreads = std::max(1u, std::thread::hardware_concurrency());
     const size_t chunkSize = fileSize / numThreads;
 
+    // Parsed as uint64_t, exactly as ConvertDecimalFile reads the same file, so the
+    // value index counts what a region conversion will keep. Bins are filled from
+    // the values that fit an int; the rest only go into the index.
     std::vector<std::vector<int>> threadNumbers(numThreads);
+    std::vector<std::vector<uint64_t>> threadWide(numThreads);
     std::vector<std::thread> threads;
 
     for (unsigned int i = 0; i < numThreads; ++i) {
-        threads.emplace_back([&, i]() {
+        threads.emplace_back([&, i, context = Trace::CurrentContext()]() {
+            Trace::ContextScope traceContext(context);
+            TRACE_SCOPE("histogram.parse_chunk");
             const char* chunkStart = data + i * chunkSize;
             const char* chunkEnd   = (i == numThreads - 1) ? dataEnd : data + (i + 1) * chunkSize;
 
-            if (i > 0) chunkStart = findNextNewline(chunkStart, dataEnd) + 1;
-            if (i < numThreads - 1) chunkEnd = findNextNewline(chunkEnd, dataEnd);
-
-            processChunk(chunkStart, chunkEnd, threadNumbers[i]);
+            if (i > 0) chunkStart = DecimalParser::FindNewline(chunkStart, dataEnd) + 1;
+            if (i < numThreads - 1) chunkEnd = DecimalParser::FindNewline(chunkEnd, dataEnd);
+
+            std::vector<uint64_t> values;
+            for (const char* block = chunkStart; block < chunkEnd; ) {
+                const char* blockEnd = DecimalParser::FindNewline(std::min(block + PARSE_BLOCK, chunkEnd), chunkEnd);
+                values.clear();
+                DecimalParser::ParseLines(block, blockEnd, values);
+                for (uint64_t v : values) {
+                    if (v <= static_cast<uint64_t>(INT_MAX)) threadNumbers[i].push_back(static_cast<int>(v));
+                    else threadWide[i].push_back(v);
+                }
+                block = blockEnd + 1;
+            }
         });
     }
     for (auto& t : threads) t.join();
@@ -96,79 +253,139 @@ MainHistogram computeHistogramFromFile(const fs::path& filePath) {
         return hist;
     }
 
-    auto percentileIndex = [&](double p) { return static_cast<size_t>(p * (allNumbers.size() - 1)); };
-
-    // 1st percentile
-    auto p1Idx = percentileIndex(0.01);
-    std::nth_element(allNumbers.begin(), allNumbers.begin() + p1Idx, allNumbers.end());
-    int minVal = allNumbers[p1Idx];
-
-    // 99th percentile
-    auto p99Idx = percentileIndex(0.99);
-    std::nth_element(allNumbers.begin(), allNumbers.begin() + p99Idx, allNumbers.end());
-    int maxVal = allNumbers[p99Idx];
+    int minVal = 0;
+    int maxVal = 0;
+    {
+        TRACE_SCOPE("histogram.percentiles");
+        auto percentileIndex = [&](double p) { return static_cast<size_t>(p * (allNumbers.size() - 1)); };
+
+        // 1st percentile
+        auto p1Idx = percentileIndex(0.01);
+        std::nth_element(allNumbers.begin(), allNumbers.begin() + p1Idx, allNumbers.end());
+        minVal = allNumbers[p1Idx];
+
+        // 99th percentile
+        auto p99Idx = percentileIndex(0.99);
+        std::nth_element(allNumbers.begin(), allNumbers.begin() + p99Idx, allNumbers.end());
+        maxVal = allNumbers[p99Idx];
+    }
 
     if (minVal >= maxVal) {
         std::cerr << "Invalid percentile min/max\n";
         return hist;
     }
 
+    if (summary) {
+        auto [lowest, highest] = std::minmax_element(allNumbers.begin(), allNumbers.end());
+        summary->sampleCount = allNumbers.size();
+        summary->minSample = *lowest;
+        summary->maxSample = *highest;
+        summary->p1 = minVal;
+        summary->p99 = maxVal;
+        summary->valueIndex = ValueIndex::FromSamples(allNumbers);   // allNumbers isn't needed past here
+        summary->valueIndex = AddWideValues(summary->valueIndex, threadWide);
+    }
+
     // Add padding - 5% of range on each side
     int range = maxVal - minVal;
     int padding = static_cast<int>(range * 0.05); // 5% padding
     minVal -= padding;
     maxVal += padding;
 
+    // Automatic resolution: one bin per integer when the range is small enough, so
+    // discrete data doesn't alias into alternating empty bins
+    uint32_t span = static_cast<uint32_t>(maxVal - minVal);
+    if (binCount == 0) {
+        if (span < static_cast<uint32_t>(MainHistogram::defaultBinCount)) {
+            span += 1;
+            binCount = span;
+        } else {
+            binCount = MainHistogram::defaultBinCount;
+        }
+    }
+    binCount = std::min(binCount, MAX_BIN_COUNT);
+
     hist.minValue = minVal;
     hist.maxValue = maxVal;
-    hist.binWidth = static_cast<double>(maxVal - minVal) / MainHistogram::binCount;
+    hist.binWidth = static_cast<double>(span) / binCount;
 
     // --- Fill bins ---
-    std::vector<std::array<int, MainHistogram::binCount>> localBins(numThreads);
-    const double scaleFactor = static_cast<double>(MainHistogram::binCount) / (maxVal - minVal);
+    const BinMapper mapper(minVal, maxVal, span, binCount);
+    const BinValuesFn fill = selectBinValues(binCount);
+    const size_t stride = binStride(binCount);
+    const size_t linesPerThread = BIN_REPLICAS * stride / 16;
+    std::vector<CacheLine> localBins(numThreads * linesPerThread);
 
     threads.clear();
     for (unsigned int i = 0; i < numThreads; ++i) {
-        threads.emplace_back([&, i]() {
-            auto& bins = localBins[i];
-            for (int value : threadNumbers[i]) {
-                if (value < minVal || value > maxVal) continue;
-                int bin = static_cast<int>((value - minVal) * scaleFactor);
-                bin = std::clamp(bin, 0, static_cast<int>(MainHistogram::binCount - 1));
-                bins[bin]++;
-            }
+        threads.emplace_back([&, i, context = Trace::CurrentContext()]() {
+            Trace::ContextScope traceContext(context);
+            TRACE_SCOPE("histogram.binning");
+            fill(threadNumbers[i], mapper, localBins[i * linesPerThread].counts, stride);
         });
     }
     for (auto& t : threads) t.join();
 
-    for (const auto& localBin : localBins) {
-        for (size_t i = 0; i < MainHistogram::binCount; ++i) hist.binCounts[i] += localBin[i];
+    std::vector<uint32_t> totals(stride, 0);
+    const uint32_t* replica = localBins.front().counts;
+    for (size_t r = 0; r < numThreads * BIN_REPLICAS; ++r, replica += stride) {
+        for (size_t i = 0; i < stride; ++i) totals[i] += replica[i];
     }
+    hist.binCounts = std::vector<int>(totals.begin(), totals.begin() + binCount);
 
-    // Gaussian smoothing for smoother histogram rendering
-    {
-        std::vector<double> smoothed(MainHistogram::binCount);
-        const double sigma = 1.5;  // tweak for more/less smoothing (1.0 = subtle, 2.5 = very smooth)
-        const int radius = static_cast<int>(std::ceil(3 * sigma));
-
-        for (size_t i = 0; i < MainHistogram::binCount; ++i) {
-            double sum = 0.0;
-            double weightSum = 0.0;
-            for (int j = -radius; j <= radius; ++j) {
-                int idx = static_cast<int>(i) + j;
-                if (idx >= 0 && idx < MainHistogram::binCount) {
-                    double w = std::exp(-0.5 * (j * j) / (sigma * sigma));
-                    sum += static_cast<double>(hist.binCounts[idx]) * w;
-                    weightSum += w;
-                }
-            }
-            smoothed[i] = sum / weightSum;
+    smoothHistogram(hist);
+
+    return hist;
+}
+
+std::vector<double> smoothCounts(const std::vector<double>& counts, SmoothingKernel kernel, double sigma) {
+    TRACE_SCOPE("histogram.smoothing");
+    if (sigma <= 0.0) return counts;
+
+    const int n = static_cast<int>(counts.size());
+    const auto kernelWeights = smoothingWeights(kernel, sigma);
+    const std::vector<double>& weights = *kernelWeights;
+    const int radius = static_cast<int>(weights.size() / 2);
+
+    // Zero-padded counts plus a matching mask, so edge bins are normalised over the taps that exist
+    std::vector<double> padded(n + 2 * radius, 0.0);
+    std::vector<double> mask(n + 2 * radius, 0.0);
+    for (int i = 0; i < n; ++i) {
+        padded[i + radius] = counts[i];
+        mask[i + radius] = 1.0;
+    }
+
+    // One multiply-add sweep per tap; the inner loops are contiguous and vectorise
+    std::vector<double> sum(n, 0.0);
+    std::vector<double> weight(n, 0.0);
+    for (size_t tap = 0; tap < weights.size(); ++tap) {
+        const double w = weights[tap];
+        const double* in = padded.data() + tap;
+        const double* valid = mask.data() + tap;
+        for (int i = 0; i < n; ++i) {
+            sum[i] += w * in[i];
+            weight[i] += w * valid[i];
         }
+    }
+    for (int i = 0; i < n; ++i) sum[i] /= weight[i];
+    return sum;
+}
+
+void smoothHistogram(MainHistogram& hist) {
+    std::vector<double> counts(hist.binCounts.begin(), hist.binCounts.end());
+    hist.smoothedCounts = smoothCounts(counts, hist.smoothingKernel, hist.smoothingSigma);
+}
 
-        // Copy back to int bins (or store separately if you want a toggle)
-        for (size_t i = 0; i < MainHistogram::binCount; ++i)
-            hist.binCounts[i] = static_cast<int>(smoothed[i]);
+const char* smoothingKernelName(SmoothingKernel kernel) {
+    switch (kernel) {
+        case SmoothingKernel::Gaussian: return "gaussian";
+        case SmoothingKernel::Box: return "box";
     }
+    return "gaussian";
+}
 
-    return hist;
+std::optional<SmoothingKernel> parseSmoothingKernel(const std::string& name) {
+    if (name == "gaussian") return SmoothingKernel::Gaussian;
+    if (name == "box") return SmoothingKernel::Box;
+    return std::nullopt;
 }
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 #include <string>
 #include <fstream>
 #include <sstream>
@@ -11,11 +12,34 @@
 #include <algorithm>
 #include <filesystem>
 #include <iostream>
+#include <optional>
 
 #include "../../core/thread_pool/thread_pool.h"
 #include "../../core/types.h"
+#include "../value_index/value_index.h"
 
 namespace fs = std::filesystem;
 
-// Compute histogram from a file
-MainHistogram computeHistogramFromFile(const fs::path& filePath);
\ No newline at end of file
+// What the parser saw, besides the bins
+struct HistogramSummary {
+    uint64_t sampleCount = 0;
+    int minSample = 0;
+    int maxSample = 0;
+    int p1 = 0;     // percentile bounds the binning range is derived from
+    int p99 = 0;
+    std::shared_ptr<const ValueIndex> valueIndex;   // exact counts per value, for region sizes
+};
+
+// Compute histogram from a file (numThreads = 0 uses every hardware thread,
+// binCount = 0 picks the resolution from the data's range)
+MainHistogram computeHistogramFromFile(const fs::path& filePath, unsigned int numThreads = 0, unsigned int binCount = 0,
+                                       HistogramSummary* summary = nullptr);
+
+// Rebuilds hist.smoothedCounts from the raw binCounts using hist's kernel and sigma
+void smoothHistogram(MainHistogram& hist);
+
+// Kernel smoothing of any bin sequence; sigma is in bins, 0 returns the counts unchanged
+std::vector<double> smoothCounts(const std::vector<double>& counts, SmoothingKernel kernel, double sigma);
+
+const char* smoothingKernelName(SmoothingKernel kernel);
+std::optional<SmoothingKernel> parseSmoothingKernel(const std::string& name);
@@ -0,0 +1,362 @@
+
+#include "histogram_cache.h"
+#include "../content_hash/content_hash.h"
+#include "../../core/trace/trace.h"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    constexpr int CACHE_VERSION = 3;                // bump when binning output changes
+    constexpr size_t SAMPLE_BLOCK_SIZE = 64u << 10;
+    constexpr int SAMPLE_BLOCKS = 5;                // first, last and three evenly spaced in between
+    constexpr size_t MEMORY_BUDGET = 256u << 20;    // bins, smoothed bins and value indexes held in memory
+
+    struct CachedHistogram {
+        HistogramCacheKey key;
+        unsigned int minValue = 0;
+        unsigned int maxValue = 0;
+        double binWidth = 0.0;
+        SharedBins<int> binCounts;
+        SharedBins<double> smoothedCounts;      // with the default kernel and sigma, as computed
+        HistogramSummary summary;
+
+        size_t Bytes() const {
+            size_t bytes = binCounts.size() * sizeof(int) + smoothedCounts.size() * sizeof(double);
+            if (summary.valueIndex) bytes += summary.valueIndex->DistinctCount() * (sizeof(int64_t) + sizeof(uint64_t));
+            return bytes;
+        }
+    };
+
+    // Process-wide, so every HistogramCache over the same directory shares hits.
+    // Least recently used entries are dropped once MEMORY_BUDGET is exceeded;
+    // the newest always stays, however large.
+    class MemoryCache {
+    private:
+        using Entry = std::pair<std::string, CachedHistogram>;
+
+        std::mutex m_mutex;
+        std::list<Entry> m_entries;     // most recently used first
+        std::unordered_map<std::string, std::list<Entry>::iterator> m_byKey;
+        size_t m_bytes = 0;
+
+        void Erase(std::list<Entry>::iterator it) {
+            m_bytes -= it->second.Bytes();
+            m_byKey.erase(it->first);
+            m_entries.erase(it);
+        }
+
+    public:
+        // A copy (bins and index are shared, not duplicated) if key is cached and still current
+        std::optional<CachedHistogram> Find(const std::string& memoryKey, const HistogramCacheKey& key) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto found = m_byKey.find(memoryKey);
+            if (found == m_byKey.end()) return std::nullopt;
+            if (!SameKey(found->second->second.key, key)) {
+                Erase(found->second);
+                return std::nullopt;
+            }
+            m_entries.splice(m_entries.begin(), m_entries, found->second);
+            return found->second->second;
+        }
+
+        void Put(const std::string& memoryKey, CachedHistogram cached) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (auto found = m_byKey.find(memoryKey); found != m_byKey.end()) Erase(found->second);
+
+            m_bytes += cached.Bytes();
+            m_entries.emplace_front(memoryKey, std::move(cached));
+            m_byKey[memoryKey] = m_entries.begin();
+            while (m_bytes > MEMORY_BUDGET && m_entries.size() > 1) Erase(std::prev(m_entries.end()));
+        }
+
+        static bool SameKey(const HistogramCacheKey& a, const HistogramCacheKey& b) {
+            return a.path == b.path && a.size == b.size && a.mtime == b.mtime &&
+                   a.sampleHash == b.sampleHash && a.binCount == b.binCount;
+        }
+    };
+
+    MemoryCache& Memory() {
+        static MemoryCache cache;
+        return cache;
+    }
+
+    bool SameSource(const HistogramCacheKey& a, const HistogramCacheKey& b) {
+        return a.path == b.path && a.size == b.size && a.mtime == b.mtime && a.sampleHash == b.sampleHash;
+    }
+
+    MainHistogram ToHistogram(const CachedHistogram& cached, HistogramSummary* summary) {
+        MainHistogram hist;
+        hist.minValue = cached.minValue;
+        hist.maxValue = cached.maxValue;
+        hist.binWidth = cached.binWidth;
+        hist.binCounts = cached.binCounts;
+        hist.smoothedCounts = cached.smoothedCounts;
+        if (summary) *summary = cached.summary;
+        return hist;
+    }
+
+    // Next to target, unique to this writer, so concurrent writes of one entry
+    // never share a temp file; renamed over target once complete
+    fs::path TempPathFor(const fs::path& target) {
+        auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+        auto tid = std::hash<std::thread::id>{}(std::this_thread::get_id());
+        fs::path tempPath = target;
+        tempPath += "." + std::to_string(stamp) + "-" + std::to_string(tid) + ".tmp";
+        return tempPath;
+    }
+
+    bool WriteJsonAtomically(const fs::path& target, const nlohmann::json& j) {
+        std::error_code ec;
+        fs::create_directories(target.parent_path(), ec);
+        const fs::path tempPath = TempPathFor(target);
+        {
+            std::ofstream out(tempPath, std::ios::out | std::ios::trunc);
+            if (!out.is_open()) {
+                std::cerr << "Failed to write histogram cache entry: " << tempPath << "\n";
+                return false;
+            }
+            out << j.dump();
+        }
+        fs::rename(tempPath, target, ec);
+        if (ec) {
+            std::cerr << "Failed to publish histogram cache entry " << target << ": " << ec.message() << "\n";
+            fs::remove(tempPath, ec);
+            return false;
+        }
+        return true;
+    }
+
+    // The entry at entryPath if it holds key; its smoothedCounts are left empty
+    std::optional<CachedHistogram> ReadEntry(const fs::path& entryPath, const HistogramCacheKey& key) {
+        std::ifstream in(entryPath);
+        if (!in) return std::nullopt;
+
+        nlohmann::json j;
+        try {
+            in >> j;
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to parse histogram cache entry " << entryPath << ": " << e.what() << "\n";
+            return std::nullopt;
+        }
+
+        CachedHistogram cached;
+        try {
+            if (j.value("version", 0) != CACHE_VERSION) return std::nullopt;
+            cached.key.path = j.at("path").get<std::string>();
+            cached.key.size = j.at("size").get<uintmax_t>();
+            cached.key.mtime = j.at("mtime").get<int64_t>();
+            cached.key.sampleHash = j.at("sampleHash").get<uint64_t>();
+            cached.key.binCount = j.at("binCount").get<unsigned int>();
+            if (!MemoryCache::SameKey(cached.key, key)) return std::nullopt;   // stale, overwritten by the next Store
+
+            cached.minValue = j.at("minValue").get<unsigned int>();
+            cached.maxValue = j.at("maxValue").get<unsigned int>();
+            cached.binWidth = j.at("binWidth").get<double>();
+            cached.binCounts = j.at("rawBins").get<std::vector<int>>();
+
+            const auto& s = j.at("summary");
+            cached.summary.sampleCount = s.at("sampleCount").get<uint64_t>();
+            cached.summary.minSample = s.at("minSample").get<int>();
+            cached.summary.maxSample = s.at("maxSample").get<int>();
+            cached.summary.p1 = s.at("p1").get<int>();
+            cached.summary.p99 = s.at("p99").get<int>();
+            if (s.contains("valueIndex")) {
+                cached.summary.valueIndex = ValueIndex::FromCounts(
+                    s["valueIndex"].at("values").get<std::vector<int64_t>>(),
+                    s["valueIndex"].at("counts").get<std::vector<uint64_t>>());
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Invalid histogram cache entry " << entryPath << ": " << e.what() << "\n";
+            return std::nullopt;
+        }
+        if (cached.binCounts.empty()) return std::nullopt;
+        return cached;
+    }
+}
+
+HistogramCache::HistogramCache(const fs::path& projectRoot)
+    : m_dir(projectRoot / "cache" / "histograms")
+{}
+
+std::optional<HistogramCacheKey> HistogramCache::KeyFor(const fs::path& filePath, unsigned int binCount) {
+    std::error_code ec;
+    HistogramCacheKey key;
+    key.path = fs::absolute(filePath, ec).lexically_normal().generic_string();
+    key.size = fs::file_size(filePath, ec);
+    if (ec) return std::nullopt;
+    key.mtime = static_cast<int64_t>(fs::last_write_time(filePath, ec).time_since_epoch().count());
+    if (ec) return std::nullopt;
+    key.binCount = binCount;
+
+    std::ifstream in(filePath, std::ios::binary);
+    if (!in) return std::nullopt;
+
+    // A few spread-out blocks catch in-place edits that keep size and mtime
+    std::vector<char> block(SAMPLE_BLOCK_SIZE);
+    uint64_t hash = key.size;
+    const uintmax_t lastOffset = key.size > SAMPLE_BLOCK_SIZE ? key.size - SAMPLE_BLOCK_SIZE : 0;
+    for (int i = 0; i < SAMPLE_BLOCKS; ++i) {
+        uintmax_t offset = lastOffset * i / (SAMPLE_BLOCKS - 1);
+        in.seekg(static_cast<std::streamoff>(offset));
+        in.read(block.data(), static_cast<std::streamsize>(block.size()));
+        hash = HashBytes(block.data(), static_cast<size_t>(in.gcount()), hash);
+        in.clear();
+        if (lastOffset == 0) break;
+    }
+    key.sampleHash = hash;
+    return key;
+}
+
+fs::path HistogramCache::EntryPath(const HistogramCacheKey& key) const {
+    std::string id = key.path + "|" + std::to_string(key.binCount);
+    return m_dir / (HashToHex(HashBytes(id.data(), id.size())) + ".json");
+}
+
+std::optional<MainHistogram> HistogramCache::Lookup(const HistogramCacheKey& key, HistogramSummary* summary) {
+    const fs::path entryPath = EntryPath(key);
+    const std::string memoryKey = entryPath.generic_string();
+
+    std::optional<CachedHistogram> cached = Memory().Find(memoryKey, key);
+    if (cached && !cached->smoothedCounts.empty()) return ToHistogram(*cached, summary);
+    if (!cached) cached = ReadEntry(entryPath, key);
+    if (!cached) return std::nullopt;
+
+    // Smoothed once here; memory hits reuse it
+    MainHistogram hist = ToHistogram(*cached, summary);
+    smoothHistogram(hist);
+    cached->smoothedCounts = hist.smoothedCounts;
+    Memory().Put(memoryKey, std::move(*cached));
+    return hist;
+}
+
+std::shared_ptr<const ValueIndex> HistogramCache::LookupValueIndex(const HistogramCacheKey& key) {
+    const fs::path entryPath = EntryPath(key);
+    const std::string memoryKey = entryPath.generic_string();
+
+    if (auto cached = Memory().Find(memoryKey, key)) return cached->summary.valueIndex;
+    auto cached = ReadEntry(entryPath, key);
+    if (!cached) return nullptr;
+
+    // Kept unsmoothed; a later Lookup smooths it then
+    std::shared_ptr<const ValueIndex> index = cached->summary.valueIndex;
+    Memory().Put(memoryKey, std::move(*cached));
+    return index;
+}
+
+void HistogramCache::Store(const HistogramCacheKey& key, const MainHistogram& hist, const HistogramSummary& summary) {
+    if (hist.binCounts.empty()) return;
+
+    const fs::path entryPath = EntryPath(key);
+    nlohmann::json j = {
+        {"version", CACHE_VERSION},
+        {"path", key.path},
+        {"size", key.size},
+        {"mtime", key.mtime},
+        {"sampleHash", key.sampleHash},
+        {"binCount", key.binCount},
+        {"minValue", hist.minValue},
+        {"maxValue", hist.maxValue},
+        {"binWidth", hist.binWidth},
+        {"rawBins", hist.binCounts.values()},
+        {"summary", {
+            {"sampleCount", summary.sampleCount},
+            {"minSample", summary.minSample},
+            {"maxSample", summary.maxSample},
+            {"p1", summary.p1},
+            {"p99", summary.p99}
+        }}
+    };
+    if (summary.valueIndex) {
+        j["summary"]["valueIndex"] = {
+            {"values", summary.valueIndex->Values()},
+            {"counts", summary.valueIndex->Counts()}
+        };
+    }
+
+    // Write then rename, so a concurrent reader never sees a half-written entry
+    if (!WriteJsonAtomically(entryPath, j)) return;
+
+    CachedHistogram cached;
+    cached.key = key;
+    cached.minValue = hist.minValue;
+    cached.maxValue = hist.maxValue;
+    cached.binWidth = hist.binWidth;
+    cached.binCounts = hist.binCounts;
+    cached.smoothedCounts = hist.smoothedCounts;
+    cached.summary = summary;
+    Memory().Put(entryPath.generic_string(), std::move(cached));
+}
+
+fs::path HistogramCache::ConversionPath(const HistogramCacheKey& source) const {
+    std::string id = source.path + "|convert";
+    return m_dir / (HashToHex(HashBytes(id.data(), id.size())) + ".json");
+}
+
+bool HistogramCache::ConversionCurrent(const HistogramCacheKey& source, const fs::path& output) const {
+    std::error_code ec;
+    const uintmax_t outputSize = fs::file_size(output, ec);
+    if (ec) return false;
+    const int64_t outputMtime = static_cast<int64_t>(fs::last_write_time(output, ec).time_since_epoch().count());
+    if (ec) return false;
+
+    std::ifstream in(ConversionPath(source));
+    if (!in) return false;
+    try {
+        nlohmann::json j;
+        in >> j;
+        HistogramCacheKey recorded;
+        recorded.path = j.at("path").get<std::string>();
+        recorded.size = j.at("size").get<uintmax_t>();
+        recorded.mtime = j.at("mtime").get<int64_t>();
+        recorded.sampleHash = j.at("sampleHash").get<uint64_t>();
+        return j.value("version", 0) == CACHE_VERSION && SameSource(recorded, source) &&
+               j.at("output").get<std::string>() == fs::absolute(output, ec).lexically_normal().generic_string() &&
+               j.at("outputSize").get<uintmax_t>() == outputSize &&
+               j.at("outputMtime").get<int64_t>() == outputMtime;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+void HistogramCache::RecordConversion(const HistogramCacheKey& source, const fs::path& output) {
+    std::error_code ec;
+    const uintmax_t outputSize = fs::file_size(output, ec);
+    if (ec) return;
+    const int64_t outputMtime = static_cast<int64_t>(fs::last_write_time(output, ec).time_since_epoch().count());
+    if (ec) return;
+
+    WriteJsonAtomically(ConversionPath(source), {
+        {"version", CACHE_VERSION},
+        {"path", source.path},
+        {"size", source.size},
+        {"mtime", source.mtime},
+        {"sampleHash", source.sampleHash},
+        {"output", fs::absolute(output, ec).lexically_normal().generic_string()},
+        {"outputSize", outputSize},
+        {"outputMtime", outputMtime}
+    });
+}
+
+MainHistogram HistogramCache::GetOrCompute(const fs::path& filePath, unsigned int binCount, HistogramSummary* summary) {
+    TRACE_SCOPE("histogram.cache");
+    auto key = KeyFor(filePath, binCount);
+    if (key) {
+        if (auto hit = Lookup(*key, summary)) return std::move(*hit);
+    }
+
+    HistogramSummary computed;
+    MainHistogram hist = computeHistogramFromFile(filePath, 0, binCount, &computed);
+    if (key) Store(*key, hist, computed);
+    if (summary) *summary = computed;
+    return hist;
+}
@@ -0,0 +1,58 @@
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "../histogram/histogram.h"
+
+namespace fs = std::filesystem;
+
+// Identity of a sample file plus the binning parameters a histogram was built with
+struct HistogramCacheKey {
+    std::string path;           // absolute, normalised
+    uintmax_t size = 0;
+    int64_t mtime = 0;
+    uint64_t sampleHash = 0;    // XXH64 over a few blocks spread through the file
+    unsigned int binCount = 0;  // as requested, 0 = automatic
+};
+
+// Persistent cache of computed histograms, one JSON entry per (file, bin count)
+// under <project>/cache/histograms.
+//
+// Entries hold the raw bins, the binning range and the parse summary. A lookup
+// re-derives the key from the file on disk (stat plus sampled blocks, no full
+// read), so an edited or replaced file is detected as stale on its own. Recent
+// hits are also kept in memory, up to a fixed budget.
+//
+// The cache also remembers which sample file each .bin conversion was made
+// from, so an unchanged file is not converted again.
+class HistogramCache {
+private:
+    fs::path m_dir;
+
+    fs::path EntryPath(const HistogramCacheKey& key) const;
+    fs::path ConversionPath(const HistogramCacheKey& source) const;
+
+public:
+    explicit HistogramCache(const fs::path& projectRoot);
+
+    static std::optional<HistogramCacheKey> KeyFor(const fs::path& filePath, unsigned int binCount);
+
+    std::optional<MainHistogram> Lookup(const HistogramCacheKey& key, HistogramSummary* summary = nullptr);
+    // Just the value index of a cached entry, without smoothing its bins; null
+    // if key is not cached or the entry has no index
+    std::shared_ptr<const ValueIndex> LookupValueIndex(const HistogramCacheKey& key);
+    void Store(const HistogramCacheKey& key, const MainHistogram& hist, const HistogramSummary& summary);
+
+    // Serves from the cache when the file is unchanged, otherwise computes and stores
+    MainHistogram GetOrCompute(const fs::path& filePath, unsigned int binCount, HistogramSummary* summary = nullptr);
+
+    // Whether output is the conversion recorded for source (binCount is ignored)
+    // and has not been touched since
+    bool ConversionCurrent(const HistogramCacheKey& source, const fs::path& output) const;
+    void RecordConversion(const HistogramCacheKey& source, const fs::path& output);
+};
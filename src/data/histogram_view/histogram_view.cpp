@@ -0,0 +1,82 @@
+
+#include "histogram_view.h"
+#include "../histogram/histogram.h"
+#include "../../core/trace/trace.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr double MIN_VIEW_SIGMA = 0.5;      // in view bins
+    // Zoomed far in, the rescaled sigma spans thousands of view bins: the plot
+    // is a flat smear well before then, and the kernel costs a frame or more
+    constexpr double MAX_VIEW_SIGMA = 64.0;
+
+    int64_t FloorDiv(int64_t a, int64_t b) {
+        int64_t q = a / b;
+        return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+    }
+}
+
+void HistogramView::Reset() {
+    m_index.reset();
+    m_start = 0;
+    m_width = 0;
+    m_binCount = 0;
+    m_sigma = -1.0;
+    m_centers.clear();
+    m_heights.clear();
+}
+
+bool HistogramView::Update(const MainHistogram& hist, double visibleMin, double visibleMax, int targetBins) {
+    if (!hist.valueIndex || hist.valueIndex->Empty() || targetBins <= 0) {
+        if (Valid()) Reset();
+        return false;
+    }
+    const ValueIndex& index = *hist.valueIndex;
+
+    // Nothing to bin past the outermost samples; value v is drawn over [v, v + 1)
+    const double lo = std::max(visibleMin, static_cast<double>(index.MinValue()));
+    const double hi = std::min(visibleMax, static_cast<double>(index.MaxValue() + 1));
+
+    int64_t start = 0;
+    int64_t width = 1;
+    int binCount = 0;
+    if (lo < hi) {
+        const int64_t first = static_cast<int64_t>(std::floor(lo));
+        const int64_t last = static_cast<int64_t>(std::ceil(hi));
+        width = std::max<int64_t>(1, (last - first + targetBins - 1) / targetBins);
+        start = FloorDiv(first, width) * width;
+        binCount = static_cast<int>((last - start + width - 1) / width);
+    }
+
+    // smoothingSigma is in bins of the precomputed histogram; the view's bins
+    // are as wide as the zoom makes them, so rescale it, skip smoothing once it
+    // narrows below half a view bin, where it would change nothing, and cap it
+    // so the kernel never reaches past the view's own bins
+    double sigma = 0.0;
+    if (hist.smoothingSigma > 0.0 && hist.binWidth > 0.0) {
+        sigma = hist.smoothingSigma * hist.binWidth / static_cast<double>(width);
+        sigma = std::min({ sigma, MAX_VIEW_SIGMA, binCount / 3.0 });
+        if (sigma < MIN_VIEW_SIGMA) sigma = 0.0;
+    }
+
+    if (hist.valueIndex == m_index && start == m_start && width == m_width && binCount == m_binCount &&
+        hist.smoothingKernel == m_kernel && sigma == m_sigma) {
+        return false;
+    }
+
+    TRACE_SCOPE("histogram.view");
+    m_index = hist.valueIndex;
+    m_start = start;
+    m_width = width;
+    m_binCount = binCount;
+    m_kernel = hist.smoothingKernel;
+    m_sigma = sigma;
+
+    const std::vector<uint64_t> counts = index.BinCounts(start, width, binCount);
+    m_heights = smoothCounts(std::vector<double>(counts.begin(), counts.end()), m_kernel, m_sigma);
+    m_centers.resize(binCount);
+    for (int i = 0; i < binCount; ++i) m_centers[i] = start + (i + 0.5) * width;
+    return true;
+}
@@ -0,0 +1,39 @@
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../../core/types.h"
+#include "../value_index/value_index.h"
+
+// Bins for whatever part of a main histogram is on screen, re-derived from its
+// value index instead of magnifying the precomputed bins. Bin width follows the
+// zoom level (whole values, never narrower than one), edges are snapped to
+// multiples of the width so panning doesn't re-phase them, and the tails outside
+// the padded p1/p99 range are included. Rebuilding only happens when the window,
+// resolution or smoothing changes, and costs one binary search per bin edge.
+class HistogramView {
+private:
+    std::shared_ptr<const ValueIndex> m_index;
+    int64_t m_start = 0;
+    int64_t m_width = 0;
+    int m_binCount = 0;
+    SmoothingKernel m_kernel = SmoothingKernel::Gaussian;
+    double m_sigma = -1.0;          // in view bins; 0 when too narrow to smooth
+
+    std::vector<double> m_centers;
+    std::vector<double> m_heights;
+
+public:
+    // Returns true if the bins were rebuilt. Without a value index the view is cleared.
+    bool Update(const MainHistogram& hist, double visibleMin, double visibleMax, int targetBins);
+    void Reset();
+
+    bool Valid() const { return m_index != nullptr; }
+    int BinCount() const { return m_binCount; }
+    double BinWidth() const { return static_cast<double>(m_width); }
+    const std::vector<double>& Centers() const { return m_centers; }
+    const std::vector<double>& Heights() const { return m_heights; }   // smoothed with the histogram's kernel, sigma rescaled to view bins and capped
+};
@@ -0,0 +1,169 @@
+
+#include "project_catalog.h"
+
+#include <algorithm>
+#include <cctype>
+#include <tuple>
+#include <unordered_set>
+
+static std::string ToLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+static bool EntryLess(const ProjectCatalogEntry& a, const ProjectCatalogEntry& b) {
+    return std::tie(a.vendor, a.repo, a.name, a.path) < std::tie(b.vendor, b.repo, b.name, b.path);
+}
+
+void ProjectCatalog::Build(std::vector<ProjectCatalogEntry> entries) {
+    for (auto& e : entries) {
+        e.searchKey = ToLower(e.vendor + " " + e.repo + " " + e.name);
+    }
+
+    // Older app.json files may list the same project twice, possibly under
+    // different names; keep the first listed, before sorting loses file order
+    std::unordered_set<std::string> seen;
+    auto last = std::remove_if(entries.begin(), entries.end(),
+                               [&](const auto& e) { return !seen.insert(e.path).second; });
+    entries.erase(last, entries.end());
+
+    std::sort(entries.begin(), entries.end(), EntryLess);
+
+    m_entries = std::move(entries);
+    RebuildStats();
+    ++m_version;
+}
+
+void ProjectCatalog::Insert(ProjectCatalogEntry entry) {
+    entry.searchKey = ToLower(entry.vendor + " " + entry.repo + " " + entry.name);
+    auto pos = std::lower_bound(m_entries.begin(), m_entries.end(), entry, EntryLess);
+    m_entries.insert(pos, std::move(entry));
+}
+
+ProjectCatalogEntry ProjectCatalog::EntryFor(const Project& project) {
+    ProjectCatalogEntry entry;
+    entry.vendor = project.vendor;
+    entry.repo = project.repo;
+    entry.name = project.name;
+    entry.path = project.path;
+    entry.oeCount = static_cast<int>(project.operationalEnvironments.size());
+    return entry;
+}
+
+void ProjectCatalog::Upsert(const Project& project) {
+    if (project.path.empty()) return;
+
+    ProjectCatalogEntry entry = EntryFor(project);
+
+    auto it = std::find_if(m_entries.begin(), m_entries.end(),
+                           [&](const auto& e) { return e.path == project.path; });
+    if (it != m_entries.end()) {
+        if (it->vendor == entry.vendor && it->repo == entry.repo &&
+            it->name == entry.name && it->oeCount == entry.oeCount) {
+            return; // nothing changed, keep the cached view
+        }
+        m_entries.erase(it);
+    }
+
+    Insert(std::move(entry));
+    RebuildStats();
+    ++m_version;
+}
+
+bool ProjectCatalog::Remove(const std::string& path) {
+    auto it = std::find_if(m_entries.begin(), m_entries.end(),
+                           [&](const auto& e) { return e.path == path; });
+    if (it == m_entries.end()) return false;
+
+    m_entries.erase(it);
+    RebuildStats();
+    ++m_version;
+    return true;
+}
+
+const ProjectCatalogEntry* ProjectCatalog::Find(const std::string& path) const {
+    auto it = std::find_if(m_entries.begin(), m_entries.end(),
+                           [&](const auto& e) { return e.path == path; });
+    return it != m_entries.end() ? &*it : nullptr;
+}
+
+void ProjectCatalog::RebuildStats() {
+    // Entries are sorted, so vendor and repo boundaries are adjacent
+    m_stats = {};
+    m_stats.projectCount = m_entries.size();
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        const auto& e = m_entries[i];
+        bool newVendor = (i == 0 || m_entries[i - 1].vendor != e.vendor);
+        bool newRepo = newVendor || m_entries[i - 1].repo != e.repo;
+        if (newVendor) ++m_stats.vendorCount;
+        if (newRepo) ++m_stats.repoCount;
+        m_stats.oeCount += static_cast<size_t>(std::max(0, e.oeCount));
+    }
+}
+
+const ProjectCatalogView& ProjectCatalog::Search(const std::string& query) const {
+    if (m_cachedVersion == m_version && m_cachedQuery == query) {
+        return m_cachedView;
+    }
+
+    m_cachedQuery = query;
+    m_cachedVersion = m_version;
+    m_cachedView = {};
+
+    std::string needle = ToLower(query);
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        if (needle.empty() || m_entries[i].searchKey.find(needle) != std::string::npos) {
+            m_cachedView.matches.push_back(static_cast<int>(i));
+        }
+    }
+
+    const auto& matches = m_cachedView.matches;
+    for (size_t i = 0; i < matches.size(); ++i) {
+        const auto& e = m_entries[matches[i]];
+        auto& vendors = m_cachedView.vendors;
+
+        if (vendors.empty() || m_entries[matches[vendors.back().begin]].vendor != e.vendor) {
+            vendors.push_back({ i, i, {} });
+        }
+        auto& vendor = vendors.back();
+
+        if (vendor.repos.empty() || m_entries[matches[vendor.repos.back().begin]].repo != e.repo) {
+            vendor.repos.push_back({ i, i });
+        }
+
+        vendor.end = i + 1;
+        vendor.repos.back().end = i + 1;
+    }
+
+    return m_cachedView;
+}
+
+void to_json(nlohmann::json& j, const ProjectCatalogEntry& e) {
+    j = nlohmann::json{
+        {"vendor", e.vendor},
+        {"repo", e.repo},
+        {"projectName", e.name},
+        {"projectPath", e.path},
+        {"oeCount", e.oeCount}
+    };
+}
+
+void from_json(const nlohmann::json& j, ProjectCatalogEntry& e) {
+    j.at("vendor").get_to(e.vendor);
+    j.at("repo").get_to(e.repo);
+    j.at("projectName").get_to(e.name);
+    j.at("projectPath").get_to(e.path);
+    e.oeCount = j.value("oeCount", 0);
+}
+
+void to_json(nlohmann::json& j, const ProjectCatalog& catalog) {
+    j = nlohmann::json::array();
+    for (const auto& e : catalog.Entries()) {
+        j.push_back(e);
+    }
+}
+
+void from_json(const nlohmann::json& j, ProjectCatalog& catalog) {
+    catalog.Build(j.get<std::vector<ProjectCatalogEntry>>());
+}
@@ -0,0 +1,82 @@
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "../../core/types.h"
+
+// Lightweight record of a saved project; this is all app.json keeps per project
+struct ProjectCatalogEntry {
+    std::string vendor;
+    std::string repo;
+    std::string name;
+    std::string path;
+    int oeCount = 0;
+
+    std::string searchKey;  // lower-cased "vendor repo name", not persisted
+};
+
+struct ProjectCatalogStats {
+    size_t vendorCount = 0;
+    size_t repoCount = 0;
+    size_t projectCount = 0;
+    size_t oeCount = 0;
+};
+
+// Search result grouped vendor -> repo, ready to be walked by a tree view
+struct ProjectCatalogView {
+    struct RepoGroup {
+        size_t begin = 0;   // range into matches
+        size_t end = 0;
+    };
+
+    struct VendorGroup {
+        size_t begin = 0;   // range into matches
+        size_t end = 0;
+        std::vector<RepoGroup> repos;
+    };
+
+    std::vector<int> matches;   // indices into ProjectCatalog::Entries()
+    std::vector<VendorGroup> vendors;
+};
+
+// Saved projects kept sorted by (vendor, repo, name). Mutations are incremental;
+// the grouped search view is cached until the query or the catalog changes.
+class ProjectCatalog {
+private:
+    std::vector<ProjectCatalogEntry> m_entries;
+    ProjectCatalogStats m_stats;
+    uint64_t m_version = 0;
+
+    mutable std::string m_cachedQuery;
+    mutable uint64_t m_cachedVersion = UINT64_MAX;
+    mutable ProjectCatalogView m_cachedView;
+
+    void Insert(ProjectCatalogEntry entry);
+    void RebuildStats();
+
+public:
+    static ProjectCatalogEntry EntryFor(const Project& project);
+
+    void Build(std::vector<ProjectCatalogEntry> entries);
+    void Upsert(const Project& project);
+    bool Remove(const std::string& path);
+
+    const ProjectCatalogEntry* Find(const std::string& path) const;
+    const std::vector<ProjectCatalogEntry>& Entries() const { return m_entries; }
+    const ProjectCatalogStats& Stats() const { return m_stats; }
+    uint64_t Version() const { return m_version; }
+    bool Empty() const { return m_entries.empty(); }
+
+    // Case-insensitive substring match over vendor, repo and name
+    const ProjectCatalogView& Search(const std::string& query) const;
+};
+
+void to_json(nlohmann::json& j, const ProjectCatalogEntry& e);
+void from_json(const nlohmann::json& j, ProjectCatalogEntry& e);
+void to_json(nlohmann::json& j, const ProjectCatalog& catalog);
+void from_json(const nlohmann::json& j, ProjectCatalog& catalog);
@@ -0,0 +1,275 @@
+
+#include "result_parser.h"
+
+#include <algorithm>
+#include <charconv>
+
+namespace {
+    std::string_view Trim(std::string_view text) {
+        while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+        while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) text.remove_suffix(1);
+        return text;
+    }
+
+    // Reads a number at the front of text (after any spaces) and drops it from text
+    template <typename T>
+    bool ReadNumber(std::string_view& text, T& value) {
+        text = Trim(text);
+        const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (ec != std::errc{}) return false;
+        text.remove_prefix(static_cast<size_t>(end - text.data()));
+        return true;
+    }
+
+    bool ConsumePrefix(std::string_view& text, std::string_view prefix) {
+        if (!text.starts_with(prefix)) return false;
+        text.remove_prefix(prefix.size());
+        return true;
+    }
+
+    template <typename T>
+    bool ReadLabelledValue(std::string_view line, std::string_view label, std::optional<T>& out) {
+        T value{};
+        if (!ConsumePrefix(line, label) || !ReadNumber(line, value)) return false;
+        out = value;
+        return true;
+    }
+
+    bool Contains(std::string_view text, std::string_view part) {
+        return text.find(part) != std::string_view::npos;
+    }
+
+    // Calls fn with each line of text, trimmed; the last one may be unterminated
+    template <typename Fn>
+    void ForEachLine(std::string_view text, Fn&& fn) {
+        while (!text.empty()) {
+            const size_t newline = text.find('\n');
+            const std::string_view line = Trim(text.substr(0, newline));
+            if (!line.empty()) fn(line);
+            if (newline == std::string_view::npos) break;
+            text.remove_prefix(newline + 1);
+        }
+    }
+}
+
+std::optional<double> NonIidReport::RunningMinimum() const {
+    if (minEntropy) return minEntropy;
+
+    std::optional<double> minimum;
+    auto consider = [&](double value) { minimum = minimum ? std::min(*minimum, value) : value; };
+    for (const auto& estimate : estimates) {
+        if (estimate.original) consider(*estimate.original);
+        if (estimate.bitstring && wordSize > 0) consider(wordSize * *estimate.bitstring);
+    }
+    return minimum;
+}
+
+bool NonIidStreamParser::Feed(std::string_view chunk) {
+    bool changed = false;
+    while (!chunk.empty()) {
+        const size_t newline = chunk.find('\n');
+        if (newline == std::string_view::npos) {
+            m_partial.append(chunk);
+            break;
+        }
+        if (m_partial.empty()) {
+            changed |= ParseLine(chunk.substr(0, newline));
+        } else {
+            m_partial.append(chunk.substr(0, newline));
+            changed |= ParseLine(m_partial);
+            m_partial.clear();
+        }
+        chunk.remove_prefix(newline + 1);
+    }
+    return changed;
+}
+
+bool NonIidStreamParser::Finish() {
+    if (m_partial.empty()) return false;
+    const bool changed = ParseLine(m_partial);
+    m_partial.clear();
+    return changed;
+}
+
+bool NonIidStreamParser::ParseLine(std::string_view line) {
+    line = Trim(line);
+    if (line.empty()) return false;
+
+    // Summary at the end of the run
+    if (ReadLabelledValue(line, "H_original:", m_report.hOriginal)) return true;
+    if (ReadLabelledValue(line, "H_bitstring:", m_report.hBitstring)) return true;
+    if (ConsumePrefix(line, "min(H_original,")) {
+        int wordSize = 0;
+        if (!ReadNumber(line, wordSize)) return false;
+        const size_t colon = line.find("):");
+        if (colon == std::string_view::npos) return false;
+        line.remove_prefix(colon + 2);
+        double value = 0.0;
+        if (!ReadNumber(line, value)) return false;
+        m_report.wordSize = wordSize;
+        m_report.minEntropy = value;
+        return true;
+    }
+
+    // "Loaded N samples of K distinct 8-bit-wide symbols"
+    if (line.starts_with("Loaded ")) {
+        const size_t wide = line.find("-bit-wide");
+        if (wide == std::string_view::npos) return false;
+        size_t start = wide;
+        while (start > 0 && line[start - 1] >= '0' && line[start - 1] <= '9') --start;
+        std::string_view digits = line.substr(start, wide - start);
+        int wordSize = 0;
+        if (!ReadNumber(digits, wordSize)) return false;
+        m_report.wordSize = wordSize;
+        return true;
+    }
+
+    // "<Name> Estimate (bit string) = 0.912 / 1 bit(s)" or "<Name> Estimate = 7.1 / 8 bit(s)";
+    // the detail lines ("Bitstring MCV Estimate: mode = ...") have a colon instead
+    const size_t marker = line.find(" Estimate");
+    if (marker == std::string_view::npos) return false;
+    const std::string_view name = line.substr(0, marker);
+    std::string_view rest = line.substr(marker + 9);
+    const bool bitstring = ConsumePrefix(rest, " (bit string)");
+    double value = 0.0;
+    if (!ConsumePrefix(rest, " = ") || !ReadNumber(rest, value)) return false;
+    int bits = 0;
+    rest = Trim(rest);
+    if (ConsumePrefix(rest, "/") && ReadNumber(rest, bits) && !bitstring && m_report.wordSize == 0) {
+        m_report.wordSize = bits;
+    }
+
+    auto it = std::find_if(m_report.estimates.begin(), m_report.estimates.end(),
+                           [&](const NonIidEstimate& e) { return e.name == name; });
+    if (it == m_report.estimates.end()) {
+        m_report.estimates.push_back({ std::string(name), std::nullopt, std::nullopt });
+        it = std::prev(m_report.estimates.end());
+    }
+    (bitstring ? it->bitstring : it->original) = value;
+    return true;
+}
+
+NonIidProgress::NonIidProgress(const NonIidProgress& other) {
+    if (other.Version() != 0) Publish(other.Snapshot());
+}
+
+NonIidProgress& NonIidProgress::operator=(const NonIidProgress& other) {
+    if (this != &other) Publish(other.Snapshot());
+    return *this;
+}
+
+void NonIidProgress::Publish(NonIidReport report) {
+    static std::atomic<uint64_t> s_lastVersion{ 0 };
+
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    m_state->report = std::move(report);
+    m_state->version.store(++s_lastVersion, std::memory_order_release);
+}
+
+NonIidReport NonIidProgress::Snapshot() const {
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    return m_state->report;
+}
+
+NonIidReport ParseNonIid(std::string_view output) {
+    NonIidStreamParser parser;
+    parser.Feed(output);
+    parser.Finish();
+    return parser.TakeReport();
+}
+
+RestartReport ParseRestart(std::string_view output) {
+    RestartReport report;
+    ForEachLine(output, [&](std::string_view line) {
+        if (ReadLabelledValue(line, "H_I:", report.hI)) return;
+        if (ReadLabelledValue(line, "H_r:", report.hRow)) return;
+        if (ReadLabelledValue(line, "H_c:", report.hColumn)) return;
+        if (ReadLabelledValue(line, "X_max:", report.xMax)) return;
+        if (ReadLabelledValue(line, "min(H_r, H_c, H_I):", report.minEntropy)) return;
+
+        // "ALPHA: 5.0e-06, X_cutoff: 37"
+        if (line.starts_with("ALPHA:")) {
+            const size_t cutoff = line.find("X_cutoff:");
+            if (cutoff != std::string_view::npos) ReadLabelledValue(line.substr(cutoff), "X_cutoff:", report.xCutoff);
+            return;
+        }
+        // "Restart Sanity Check Passed..." / "*** Restart Sanity Check Failed ***"
+        if (Contains(line, "Sanity Check")) {
+            report.sanityPassed = Contains(line, "Passed");
+            return;
+        }
+        // "Validation Test Passed..." / "*** min(H_r, H_c) < H_I/2, Validation Testing Failed ***"
+        if (Contains(line, "Validation Test")) {
+            report.validationPassed = Contains(line, "Passed");
+        }
+    });
+    return report;
+}
+
+DecimationOutcome DecimationReport::Outcome() const {
+    if (rate) return DecimationOutcome::Passed;
+    if (noDecimationRequired) return DecimationOutcome::NoDecimationRequired;
+    if (maxDecimationFails) return DecimationOutcome::MaxDecimationFails;
+    if (moreDataRequired) return DecimationOutcome::MoreDataRequired;
+    return DecimationOutcome::Unknown;
+}
+
+std::string DecimationReport::Summary() const {
+    switch (Outcome()) {
+        case DecimationOutcome::Passed:
+            return "Passed: Found passing decimation rate: " + std::to_string(*rate);
+        case DecimationOutcome::NoDecimationRequired:
+            return "Failed: No decimation required to test using the essentially IID approach.";
+        case DecimationOutcome::MaxDecimationFails:
+            return "Failed: Proceed with the non-decimated data using empirical approach.";
+        case DecimationOutcome::MoreDataRequired:
+            return "Error: More data is required to test with the provided decimation level.";
+        case DecimationOutcome::Unknown:
+            break;
+    }
+    return "Decimation result could not be determined";
+}
+
+DecimationReport ParseDecimation(std::string_view output) {
+    constexpr std::string_view RATE = "The first passing decimation rate is";
+    constexpr std::string_view VERSION = "find-first-passing-decimation.pl version";
+
+    DecimationReport report;
+    ForEachLine(output, [&](std::string_view line) {
+        if (ConsumePrefix(line, VERSION)) {
+            report.scriptVersion = std::string(Trim(line));
+            return;
+        }
+        if (const size_t at = line.find(RATE); at != std::string_view::npos) {
+            std::string_view rest = line.substr(at + RATE.size());
+            rest = Trim(rest);
+            ConsumePrefix(rest, ":");
+            int rate = 0;
+            if (ReadNumber(rest, rate)) report.rate = rate;
+            return;
+        }
+        if (Contains(line, "Invariant failed: No decimation passes IID testing")) {
+            report.noDecimationRequired = true;
+        } else if (Contains(line, "Invariant failed: Max decimation fails IID testing")) {
+            report.maxDecimationFails = true;
+        } else if (Contains(line, "More data is required to test with the provided decimation level")) {
+            report.moreDataRequired = true;
+        }
+    });
+    return report;
+}
+
+std::string ParseDecimationScriptVersion(std::string_view script) {
+    constexpr std::string_view HEADER = "# find-first-passing-decimation.pl version";
+
+    for (size_t at = script.find(HEADER); at != std::string_view::npos; at = script.find(HEADER, at + 1)) {
+        std::string_view rest = script.substr(at + HEADER.size());
+        rest = rest.substr(0, rest.find('\n'));
+        int major = 0, minor = 0, patch = 0;
+        if (!ReadNumber(rest, major) || !ConsumePrefix(rest, ".")) continue;
+        if (!ReadNumber(rest, minor) || !ConsumePrefix(rest, ".")) continue;
+        if (!ReadNumber(rest, patch)) continue;
+        return std::to_string(major) + "." + std::to_string(minor) + "." + std::to_string(patch);
+    }
+    return {};
+}
@@ -0,0 +1,135 @@
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Hand-written, single-pass parsers for the output of the external tools:
+// ea_non_iid, ea_restart and find-first-passing-decimation.pl. Each walks the
+// text once, line by line, and fills a typed record; unknown lines are skipped,
+// so chatter added by newer tool versions does not break parsing.
+
+// ea_non_iid runs ten estimators, each on the samples as given and on their bitstring
+constexpr size_t NON_IID_ESTIMATOR_COUNT = 10;
+
+// One ea_non_iid estimator and the min-entropy it reported for each pass
+struct NonIidEstimate {
+    std::string name;                   // as printed, without " Estimate", e.g. "Most Common Value"
+    std::optional<double> original;     // bits per sample
+    std::optional<double> bitstring;    // bits per bit
+};
+
+// Everything read from one ea_non_iid run so far
+struct NonIidReport {
+    std::vector<NonIidEstimate> estimates;      // in the order the tool reported them
+    int wordSize = 0;                           // bits per sample; 0 until the tool says
+    std::optional<double> hOriginal;
+    std::optional<double> hBitstring;
+    std::optional<double> minEntropy;           // min(H_original, wordSize x H_bitstring)
+
+    bool Complete() const { return hOriginal && hBitstring && minEntropy; }
+
+    // The assessment over the estimates reported so far; it only goes down
+    // as more arrive and equals minEntropy once the run completes
+    std::optional<double> RunningMinimum() const;
+};
+
+// Parses ea_non_iid -v output line by line as it arrives. Chunks may split
+// lines anywhere; the unterminated tail is kept for the next Feed.
+class NonIidStreamParser {
+private:
+    NonIidReport m_report;
+    std::string m_partial;
+
+    bool ParseLine(std::string_view line);
+
+public:
+    // true when the chunk completed a line that changed the report
+    bool Feed(std::string_view chunk);
+    // Parses a last line the tool did not terminate
+    bool Finish();
+
+    const NonIidReport& Report() const { return m_report; }
+    NonIidReport TakeReport() { return std::move(m_report); }
+};
+
+// Live ea_non_iid progress: published by the worker feeding the parser, read
+// by the UI. It lives in the copyable project structs next to the TestTimer of
+// the same run; a copy starts from a snapshot and does not follow the run.
+class NonIidProgress {
+private:
+    struct State {
+        std::mutex mutex;
+        NonIidReport report;
+        std::atomic<uint64_t> version{ 0 };
+    };
+    std::unique_ptr<State> m_state = std::make_unique<State>();
+
+public:
+    NonIidProgress() = default;
+    NonIidProgress(const NonIidProgress& other);
+    NonIidProgress& operator=(const NonIidProgress& other);
+
+    void Publish(NonIidReport report);
+    void Clear() { Publish({}); }
+
+    NonIidReport Snapshot() const;
+    // Changes on every Publish and is unique across instances; 0 until the
+    // first one, so a reader can cache the Snapshot by version alone
+    uint64_t Version() const { return m_state->version.load(std::memory_order_acquire); }
+};
+
+NonIidReport ParseNonIid(std::string_view output);
+
+// ea_restart -v: the sanity check on the row/column counts, then the row and
+// column assessments validated against H_I
+struct RestartReport {
+    std::optional<double> hI;               // min-entropy under test
+    std::optional<int> xCutoff;
+    std::optional<int> xMax;
+    std::optional<bool> sanityPassed;       // X_max <= X_cutoff
+    std::optional<double> hRow;             // H_r
+    std::optional<double> hColumn;          // H_c
+    std::optional<bool> validationPassed;   // min(H_r, H_c) >= H_I / 2
+    std::optional<double> minEntropy;       // min(H_r, H_c, H_I)
+
+    bool Passed() const { return sanityPassed.value_or(false) && validationPassed.value_or(false); }
+};
+
+RestartReport ParseRestart(std::string_view output);
+
+enum class DecimationOutcome {
+    Unknown,
+    Passed,                     // rate holds the first passing decimation rate
+    NoDecimationRequired,       // no decimation passes IID testing
+    MaxDecimationFails,         // proceed with the non-decimated data
+    MoreDataRequired
+};
+
+// find-first-passing-decimation.pl output, with the version line that
+// findFirstPassingDecimation puts in front of it
+struct DecimationReport {
+    std::string scriptVersion;
+    std::optional<int> rate;
+    bool noDecimationRequired = false;
+    bool maxDecimationFails = false;
+    bool moreDataRequired = false;
+
+    // A found rate wins over the invariant failures, which win over missing data
+    DecimationOutcome Outcome() const;
+    // The one-line result shown in the UI and stored in the project
+    std::string Summary() const;
+};
+
+DecimationReport ParseDecimation(std::string_view output);
+
+// "1.2.3" from the "# find-first-passing-decimation.pl version 1.2.3" header
+// of the script itself; empty if there is none
+std::string ParseDecimationScriptVersion(std::string_view script);
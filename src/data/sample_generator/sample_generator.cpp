@@ -0,0 +1,282 @@
+
+#include "sample_generator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr uint64_t BLOCK_SAMPLES = 1u << 18;   // samples per independently seeded block
+    constexpr double TWO_PI = 6.283185307179586;
+
+    uint64_t SplitMix64(uint64_t& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // xoshiro256** - small, fast, and good enough for load data
+    class Rng {
+    private:
+        uint64_t s[4];
+
+        static uint64_t Rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    public:
+        explicit Rng(uint64_t seed) {
+            for (auto& word : s) word = SplitMix64(seed);
+        }
+
+        uint64_t Next() {
+            uint64_t result = Rotl(s[1] * 5, 7) * 9;
+            uint64_t t = s[1] << 17;
+            s[2] ^= s[0];
+            s[3] ^= s[1];
+            s[1] ^= s[2];
+            s[0] ^= s[3];
+            s[2] ^= t;
+            s[3] = Rotl(s[3], 45);
+            return result;
+        }
+
+        // Uniform in [0, 1)
+        double Uniform() { return static_cast<double>(Next() >> 11) * 0x1.0p-53; }
+    };
+
+    class Sampler {
+    private:
+        const SampleGeneratorConfig& m_config;
+        Rng m_rng;
+        bool m_hasSpare = false;
+        double m_spare = 0.0;
+
+        // Box-Muller, keeping the second value of each pair
+        double Gaussian() {
+            if (m_hasSpare) {
+                m_hasSpare = false;
+                return m_spare;
+            }
+            double u1 = 1.0 - m_rng.Uniform();     // (0, 1], keeps log finite
+            double u2 = m_rng.Uniform();
+            double r = std::sqrt(-2.0 * std::log(u1));
+            m_spare = r * std::sin(TWO_PI * u2);
+            m_hasSpare = true;
+            return r * std::cos(TWO_PI * u2);
+        }
+
+    public:
+        Sampler(const SampleGeneratorConfig& config, uint64_t blockIndex)
+            : m_config(config), m_rng(config.seed ^ (blockIndex * 0xD1B54A32D192ED03ULL))
+        {}
+
+        uint32_t Next(uint64_t sampleIndex) {
+            const auto& c = m_config;
+
+            if (c.outlierRate > 0.0 && m_rng.Uniform() < c.outlierRate) {
+                return static_cast<uint32_t>(m_rng.Uniform() * c.outlierMax);
+            }
+
+            double value = 0.0;
+            switch (c.distribution) {
+                case SampleDistribution::Normal:
+                    value = c.mean + c.stddev * Gaussian();
+                    break;
+                case SampleDistribution::MultiModal: {
+                    int modes = std::max(1, c.modes);
+                    int mode = static_cast<int>(m_rng.Uniform() * modes);
+                    double offset = (mode - (modes - 1) * 0.5) * c.modeSpacing;
+                    value = c.mean + offset + c.stddev * Gaussian();
+                    break;
+                }
+                case SampleDistribution::HeavyTail: {
+                    double scale = std::pow(1.0 - m_rng.Uniform(), -1.0 / c.tailAlpha);
+                    value = c.mean + c.stddev * Gaussian() * scale;
+                    break;
+                }
+                case SampleDistribution::Drift: {
+                    double progress = c.sampleCount > 1
+                        ? static_cast<double>(sampleIndex) / static_cast<double>(c.sampleCount - 1)
+                        : 0.0;
+                    value = c.mean + c.drift * progress + c.stddev * Gaussian();
+                    break;
+                }
+            }
+
+            if (value < 0.0) return 0;
+            if (value >= 4294967295.0) return UINT32_MAX;
+            return static_cast<uint32_t>(value + 0.5);
+        }
+    };
+
+    void FormatBlock(const SampleGeneratorConfig& config, uint64_t block, std::vector<char>& buffer,
+                     std::array<uint64_t, 256>& lsbCounts)
+    {
+        uint64_t first = block * BLOCK_SAMPLES;
+        uint64_t count = std::min(BLOCK_SAMPLES, config.sampleCount - first);
+
+        // 10 digits + " 0\n" per sample at most
+        buffer.resize(count * 13);
+        char* out = buffer.data();
+
+        Sampler sampler(config, block);
+        for (uint64_t i = 0; i < count; ++i) {
+            uint32_t value = sampler.Next(first + i);
+            lsbCounts[value & 0xFF]++;
+
+            out = std::to_chars(out, out + 10, value).ptr;
+            if (config.secondColumn) {
+                *out++ = ' ';
+                *out++ = '0';
+            }
+            *out++ = '\n';
+        }
+        buffer.resize(static_cast<size_t>(out - buffer.data()));
+    }
+}
+
+std::optional<SampleDistribution> ParseSampleDistribution(const std::string& name) {
+    if (name == "normal") return SampleDistribution::Normal;
+    if (name == "multimodal") return SampleDistribution::MultiModal;
+    if (name == "heavytail") return SampleDistribution::HeavyTail;
+    if (name == "drift") return SampleDistribution::Drift;
+    return std::nullopt;
+}
+
+bool ParseCount(const std::string& text, uint64_t& count) {
+    if (text.empty()) return false;
+    double multiplier = 1.0;
+    std::string number = text;
+    switch (text.back()) {
+        case 'k': case 'K': multiplier = 1e3; number.pop_back(); break;
+        case 'm': case 'M': multiplier = 1e6; number.pop_back(); break;
+        case 'g': case 'G': multiplier = 1e9; number.pop_back(); break;
+    }
+    try {
+        size_t used = 0;
+        double value = std::stod(number, &used) * multiplier;
+        if (used != number.size() || !(value >= 1.0) || value >= 1.8e19) return false;
+        count = static_cast<uint64_t>(value);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+const char* SampleDistributionName(SampleDistribution distribution) {
+    switch (distribution) {
+        case SampleDistribution::Normal: return "normal";
+        case SampleDistribution::MultiModal: return "multimodal";
+        case SampleDistribution::HeavyTail: return "heavytail";
+        case SampleDistribution::Drift: return "drift";
+    }
+    return "unknown";
+}
+
+std::optional<SampleGeneratorStats> GenerateSampleFile(const fs::path& outPath, const SampleGeneratorConfig& config) {
+    std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Cannot create sample file: " << outPath << "\n";
+        return std::nullopt;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    const uint64_t blockCount = (config.sampleCount + BLOCK_SAMPLES - 1) / BLOCK_SAMPLES;
+    unsigned int threadCount = config.threads ? config.threads : std::max(1u, std::thread::hardware_concurrency());
+    threadCount = static_cast<unsigned int>(std::min<uint64_t>(threadCount, std::max<uint64_t>(1, blockCount)));
+
+    SampleGeneratorStats stats;
+    std::atomic<uint64_t> nextBlock{0};
+
+    // Blocks are formatted concurrently but handed to the stream strictly in order
+    std::mutex writeMutex;
+    std::condition_variable writeTurn;
+    uint64_t nextToWrite = 0;
+    bool failed = false;
+
+    auto worker = [&] {
+        std::vector<char> buffer;
+        std::array<uint64_t, 256> lsbCounts{};
+
+        for (;;) {
+            uint64_t block = nextBlock.fetch_add(1);
+            if (block >= blockCount) break;
+
+            FormatBlock(config, block, buffer, lsbCounts);
+
+            std::unique_lock<std::mutex> lock(writeMutex);
+            writeTurn.wait(lock, [&] { return nextToWrite == block || failed; });
+            if (!failed) {
+                out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                if (!out) failed = true;
+                stats.bytes += buffer.size();
+            }
+            ++nextToWrite;
+            writeTurn.notify_all();
+        }
+
+        std::lock_guard<std::mutex> lock(writeMutex);
+        for (size_t i = 0; i < lsbCounts.size(); ++i) stats.lsbCounts[i] += lsbCounts[i];
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i < threadCount; ++i) threads.emplace_back(worker);
+    for (auto& t : threads) t.join();
+
+    out.close();
+    if (failed || !out) {
+        std::cerr << "Failed writing sample file: " << outPath << "\n";
+        return std::nullopt;
+    }
+
+    stats.samples = config.sampleCount;
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (stats.samples > 0) {
+        uint64_t maxCount = *std::max_element(stats.lsbCounts.begin(), stats.lsbCounts.end());
+        stats.lsbMinEntropy = -std::log2(static_cast<double>(maxCount) / stats.samples);
+        for (uint64_t count : stats.lsbCounts) {
+            if (count == 0) continue;
+            double p = static_cast<double>(count) / stats.samples;
+            stats.lsbShannonEntropy -= p * std::log2(p);
+        }
+    }
+
+    return stats;
+}
+
+nlohmann::json SampleGeneratorReport(const SampleGeneratorConfig& config, const SampleGeneratorStats& stats) {
+    nlohmann::json j;
+    j["generator"] = {
+        {"sampleCount", config.sampleCount},
+        {"seed", config.seed},
+        {"distribution", SampleDistributionName(config.distribution)},
+        {"mean", config.mean},
+        {"stddev", config.stddev},
+        {"modes", config.modes},
+        {"modeSpacing", config.modeSpacing},
+        {"tailAlpha", config.tailAlpha},
+        {"drift", config.drift},
+        {"outlierRate", config.outlierRate},
+        {"outlierMax", config.outlierMax},
+        {"secondColumn", config.secondColumn}
+    };
+    j["samples"] = stats.samples;
+    j["bytes"] = stats.bytes;
+    j["seconds"] = stats.seconds;
+    j["lsb8"] = {
+        {"minEntropy", stats.lsbMinEntropy},
+        {"shannonEntropy", stats.lsbShannonEntropy},
+        {"counts", stats.lsbCounts}
+    };
+    return j;
+}
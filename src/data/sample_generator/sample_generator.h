@@ -0,0 +1,65 @@
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+namespace fs = std::filesystem;
+
+enum class SampleDistribution {
+    Normal,         // single Gaussian around mean
+    MultiModal,     // `modes` Gaussians spaced `modeSpacing` apart, chosen uniformly
+    HeavyTail,      // Gaussian scaled by a Pareto(tailAlpha) factor: power-law tails
+    Drift           // Gaussian whose mean moves linearly by `drift` over the file
+};
+
+std::optional<SampleDistribution> ParseSampleDistribution(const std::string& name);
+const char* SampleDistributionName(SampleDistribution distribution);
+
+// A sample count from the command line: plain integers, scientific notation
+// (1e9) and k/M/G suffixes; false for anything else or a count below one
+bool ParseCount(const std::string& text, uint64_t& count);
+
+struct SampleGeneratorConfig {
+    uint64_t sampleCount = 1'000'000;
+    uint64_t seed = 1;
+    unsigned int threads = 0;               // 0 = hardware concurrency
+
+    SampleDistribution distribution = SampleDistribution::Normal;
+    double mean = 5000.0;
+    double stddev = 300.0;
+    int modes = 3;
+    double modeSpacing = 800.0;
+    double tailAlpha = 3.0;
+    double drift = 1000.0;                  // total mean shift from first to last sample
+    double outlierRate = 0.0;               // fraction replaced by uniform [0, outlierMax]
+    double outlierMax = 100000.0;
+
+    bool secondColumn = true;               // "value 0" lines, like raw JENT dumps
+};
+
+// What was written, plus the entropy of the LSB-8 symbols ConvertDecimalFile will extract
+struct SampleGeneratorStats {
+    uint64_t samples = 0;
+    uint64_t bytes = 0;
+    double seconds = 0.0;
+    std::array<uint64_t, 256> lsbCounts{};
+    double lsbMinEntropy = 0.0;             // -log2(max p), bits per 8-bit symbol
+    double lsbShannonEntropy = 0.0;
+};
+
+// Writes newline-separated decimal samples to outPath.
+//
+// Samples are produced in fixed-size blocks, each with its own RNG seeded from
+// (seed, block index), so the output is byte-identical for a given config no
+// matter how many threads generate it. Blocks are formatted in parallel and
+// written in order.
+std::optional<SampleGeneratorStats> GenerateSampleFile(const fs::path& outPath, const SampleGeneratorConfig& config);
+
+// Sidecar description of a generated file (config + stats)
+nlohmann::json SampleGeneratorReport(const SampleGeneratorConfig& config, const SampleGeneratorStats& stats);
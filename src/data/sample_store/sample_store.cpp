@@ -0,0 +1,291 @@
+
+#include "sample_store.h"
+#include "../content_hash/content_hash.h"
+#include "../../core/thread_pool/thread_pool.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr size_t HASH_BLOCK_SIZE = 8u << 20; // 8 MiB per hashed block
+    // Blocks in flight per import; hashing keeps up with the disk long before
+    // the core count matters, so this bounds memory rather than tracking it
+    constexpr size_t HASH_SLOTS = 4;
+
+    // Shared by every import, so uploading doesn't start threads each time
+    ThreadPool& HashPool() {
+        static ThreadPool pool(HASH_SLOTS);
+        return pool;
+    }
+
+    // Two independent seeds over the block hash list give a 128-bit digest
+    constexpr uint64_t DIGEST_SEED_LOW = 0x9E3779B97F4A7C15ULL;
+    constexpr uint64_t DIGEST_SEED_HIGH = 0xC2B2AE3D27D4EB4FULL;
+
+    nlohmann::json LoadIndex(const fs::path& indexPath) {
+        nlohmann::json index;
+        std::ifstream in(indexPath);
+        if (in) {
+            try {
+                in >> index;
+            } catch (const std::exception& e) {
+                std::cerr << "Failed to parse sample store index: " << e.what() << "\n";
+                index = nlohmann::json();
+            }
+        }
+        if (!index.is_object()) index = nlohmann::json::object();
+        if (!index.contains("sources") || !index["sources"].is_array()) index["sources"] = nlohmann::json::array();
+        if (!index.contains("objects") || !index["objects"].is_object()) index["objects"] = nlohmann::json::object();
+        return index;
+    }
+}
+
+SampleStore::SampleStore(const fs::path& projectRoot)
+    : m_root(projectRoot / "samples")
+{}
+
+std::optional<StoredSample> SampleStore::Import(const fs::path& sourcePath, const fs::path& destDir) {
+    std::error_code ec;
+    if (!fs::exists(sourcePath)) {
+        std::cerr << "Source file does not exist: " << sourcePath << "\n";
+        return std::nullopt;
+    }
+
+    uintmax_t size = fs::file_size(sourcePath, ec);
+    int64_t mtime = 0;
+    if (!ec) mtime = static_cast<int64_t>(fs::last_write_time(sourcePath, ec).time_since_epoch().count());
+    if (ec) {
+        std::cerr << "Cannot stat sample file: " << sourcePath << " (" << ec.message() << ")\n";
+        return std::nullopt;
+    }
+
+    fs::path objectsDir = m_root / "objects";
+    fs::create_directories(objectsDir, ec);
+    if (!ec) fs::create_directories(destDir, ec);
+    if (ec) {
+        std::cerr << "Failed to create sample store directories: " << ec.message() << "\n";
+        return std::nullopt;
+    }
+
+    StoredSample sample;
+    sample.linkPath = (destDir / sourcePath.filename()).make_preferred();
+
+    auto known = LookupSource(sourcePath, size, mtime);
+    if (known && fs::exists(objectsDir / *known)) {
+        // Same file as last time: no read, no hash, no copy
+        sample.digest = *known;
+        sample.reused = true;
+    } else {
+        auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+        auto tid = std::hash<std::thread::id>{}(std::this_thread::get_id());
+        fs::path tempPath = objectsDir / ("incoming-" + std::to_string(stamp) + "-" + std::to_string(tid));
+
+        auto digest = CopyAndHash(sourcePath, tempPath);
+        if (!digest) {
+            fs::remove(tempPath, ec);
+            return std::nullopt;
+        }
+
+        sample.digest = *digest;
+        fs::path objectPath = objectsDir / sample.digest;
+        if (fs::exists(objectPath)) {
+            fs::remove(tempPath, ec);
+            sample.reused = true;
+        } else {
+            fs::rename(tempPath, objectPath, ec);
+            if (ec) {
+                std::cerr << "Failed to store sample object: " << objectPath << " (" << ec.message() << ")\n";
+                fs::remove(tempPath, ec);
+                return std::nullopt;
+            }
+        }
+    }
+
+    sample.objectPath = (objectsDir / sample.digest).make_preferred();
+
+    bool alreadyLinked = fs::exists(sample.linkPath) && fs::equivalent(sample.linkPath, sample.objectPath, ec);
+    if (!alreadyLinked) {
+        fs::remove(sample.linkPath, ec);
+        if (!LinkObject(sample.objectPath, sample.linkPath)) {
+            return std::nullopt;
+        }
+    }
+
+    RecordImport(sourcePath, size, mtime, sample.digest, sample.linkPath);
+    return sample;
+}
+
+std::optional<std::string> SampleStore::LookupSource(const fs::path& sourcePath, uintmax_t size, int64_t mtime) {
+    nlohmann::json index = LoadIndex(m_root / "index.json");
+    std::string source = fs::absolute(sourcePath).lexically_normal().generic_string();
+
+    for (const auto& entry : index["sources"]) {
+        if (entry.value("path", "") == source &&
+            entry.value("size", uintmax_t{0}) == size &&
+            entry.value("mtime", int64_t{0}) == mtime)
+        {
+            return entry.value("digest", "");
+        }
+    }
+    return std::nullopt;
+}
+
+void SampleStore::RecordImport(const fs::path& sourcePath, uintmax_t size, int64_t mtime,
+                               const std::string& digest, const fs::path& linkPath)
+{
+    fs::path indexPath = m_root / "index.json";
+    nlohmann::json index = LoadIndex(indexPath);
+    std::string source = fs::absolute(sourcePath).lexically_normal().generic_string();
+
+    auto& sources = index["sources"];
+    for (auto it = sources.begin(); it != sources.end(); ) {
+        if (it->value("path", "") == source) it = sources.erase(it);
+        else ++it;
+    }
+    sources.push_back({ {"path", source}, {"size", size}, {"mtime", mtime}, {"digest", digest} });
+
+    auto& object = index["objects"][digest];
+    object["size"] = size;
+    if (!object.contains("links") || !object["links"].is_array()) object["links"] = nlohmann::json::array();
+
+    std::string link = fs::relative(linkPath, m_root.parent_path()).generic_string();
+    auto& links = object["links"];
+    if (std::find(links.begin(), links.end(), link) == links.end()) links.push_back(link);
+
+    std::ofstream out(indexPath, std::ios::out | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Failed to write sample store index: " << indexPath << "\n";
+        return;
+    }
+    out << index.dump(4);
+}
+
+std::optional<std::string> SampleStore::CopyAndHash(const fs::path& sourcePath, const fs::path& tempPath) {
+    std::ifstream in(sourcePath, std::ios::binary);
+    if (!in) {
+        std::cerr << "Cannot open sample file: " << sourcePath << "\n";
+        return std::nullopt;
+    }
+
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Cannot create sample object: " << tempPath << "\n";
+        return std::nullopt;
+    }
+
+    // Reading and writing stay sequential; blocks are hashed on the shared pool
+    // while the next ones are read. A slot's buffer is reused only after the
+    // hash that reads it has been collected, which also keeps hashes in order.
+    const size_t slots = HASH_SLOTS;
+    std::vector<std::vector<char>> buffers(slots);
+    std::vector<std::future<uint64_t>> pending(slots);
+    std::vector<uint64_t> blockHashes;
+    ThreadPool& hashers = HashPool();
+
+    size_t block = 0;
+    for (;; ++block) {
+        size_t slot = block % slots;
+        if (pending[slot].valid()) blockHashes.push_back(pending[slot].get());
+
+        auto& buffer = buffers[slot];
+        buffer.resize(HASH_BLOCK_SIZE);
+        in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        size_t count = static_cast<size_t>(in.gcount());
+        if (count == 0) break;
+
+        out.write(buffer.data(), static_cast<std::streamsize>(count));
+        if (!out) {
+            std::cerr << "Failed writing sample object: " << tempPath << "\n";
+            for (auto& f : pending) if (f.valid()) f.wait();
+            return std::nullopt;
+        }
+
+        pending[slot] = hashers.Enqueue([&buffer, count, block] {
+            return HashBytes(buffer.data(), count, block);
+        });
+    }
+
+    for (size_t k = 1; k < slots; ++k) {
+        size_t slot = (block + k) % slots;
+        if (pending[slot].valid()) blockHashes.push_back(pending[slot].get());
+    }
+
+    if (in.bad()) {
+        std::cerr << "Failed reading sample file: " << sourcePath << "\n";
+        return std::nullopt;
+    }
+
+    out.close();
+    if (!out) {
+        std::cerr << "Failed to finalise sample object: " << tempPath << "\n";
+        return std::nullopt;
+    }
+
+    blockHashes.push_back(static_cast<uint64_t>(fs::file_size(tempPath)));
+
+    size_t bytes = blockHashes.size() * sizeof(uint64_t);
+    return HashToHex(HashBytes(blockHashes.data(), bytes, DIGEST_SEED_HIGH)) +
+           HashToHex(HashBytes(blockHashes.data(), bytes, DIGEST_SEED_LOW));
+}
+
+bool SampleStore::LinkObject(const fs::path& objectPath, const fs::path& linkPath) {
+    std::error_code ec;
+
+#ifdef __linux__
+    // Reflink first: shares extents but stays copy-on-write, so edits in the OE folder can't touch the store
+    {
+        int src = ::open(objectPath.c_str(), O_RDONLY);
+        if (src >= 0) {
+            int dst = ::open(linkPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            bool cloned = dst >= 0 && ::ioctl(dst, FICLONE, src) == 0;
+            if (dst >= 0) ::close(dst);
+            ::close(src);
+            if (cloned) return true;
+            fs::remove(linkPath, ec);
+        }
+    }
+#endif
+
+    // A hard link (the only kind on Windows) aliases the object itself, so an
+    // in-place write through one OE folder would change every project sharing
+    // it. Objects never change once stored; make them read-only first, which
+    // every hard link shares, so such a write fails instead.
+    constexpr fs::perms WRITE = fs::perms::owner_write | fs::perms::group_write | fs::perms::others_write;
+    fs::permissions(objectPath, WRITE, fs::perm_options::remove, ec);
+    if (!ec) {
+        fs::create_hard_link(objectPath, linkPath, ec);
+        if (!ec) return true;
+    }
+
+    fs::copy_file(objectPath, linkPath, fs::copy_options::overwrite_existing, ec);
+    if (ec) {
+        std::cerr << "Error linking sample file: " << ec.message() << "\n";
+        return false;
+    }
+    // A private copy may stay writable
+    fs::permissions(linkPath, fs::perms::owner_write, fs::perm_options::add, ec);
+    return true;
+}
+
+std::optional<fs::path> ImportSampleFile(const fs::path& sourcePath, const fs::path& projectRoot, const fs::path& destDir) {
+    SampleStore store(projectRoot);
+    if (auto sample = store.Import(sourcePath, destDir)) {
+        return sample->linkPath;
+    }
+    return std::nullopt;
+}
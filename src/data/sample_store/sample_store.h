@@ -0,0 +1,46 @@
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+namespace fs = std::filesystem;
+
+struct StoredSample {
+    std::string digest;     // content digest, also the object's file name
+    fs::path objectPath;    // <project>/samples/objects/<digest>
+    fs::path linkPath;      // file placed in the OE directory
+    bool reused = false;    // true when the content was already in the store
+};
+
+// Content-addressed store for raw sample files inside a project.
+//
+// Each distinct file is stored once under samples/objects/<digest>; OE folders
+// get a reflink, hardlink or (as a last resort) a copy of that object under the
+// original file name. Objects are read-only, so a hardlinked OE file is too.
+//
+// samples/index.json remembers the digest of every imported source (path,
+// size, mtime), so re-importing an unchanged file skips hashing.
+class SampleStore {
+private:
+    fs::path m_root;
+
+    std::optional<std::string> LookupSource(const fs::path& sourcePath, uintmax_t size, int64_t mtime);
+    void RecordImport(const fs::path& sourcePath, uintmax_t size, int64_t mtime,
+                      const std::string& digest, const fs::path& linkPath);
+
+    // Copies sourcePath into a temp object while hashing it block-parallel
+    std::optional<std::string> CopyAndHash(const fs::path& sourcePath, const fs::path& tempPath);
+
+    static bool LinkObject(const fs::path& objectPath, const fs::path& linkPath);
+
+public:
+    explicit SampleStore(const fs::path& projectRoot);
+
+    std::optional<StoredSample> Import(const fs::path& sourcePath, const fs::path& destDir);
+};
+
+// Imports sourcePath through the project's sample store; returns the file placed in destDir
+std::optional<fs::path> ImportSampleFile(const fs::path& sourcePath, const fs::path& projectRoot, const fs::path& destDir);
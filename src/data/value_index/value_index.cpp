@@ -0,0 +1,96 @@
+
+#include "value_index.h"
+#include "../../core/trace/trace.h"
+
+#include <algorithm>
+
+namespace {
+    // Dense counting beats a sort while the value range stays within a few MB of counters
+    constexpr int64_t MAX_DENSE_SPAN = 1 << 22;
+}
+
+std::shared_ptr<const ValueIndex> ValueIndex::FromSamples(std::vector<int>& samples) {
+    TRACE_SCOPE("value_index.build");
+    auto index = std::make_shared<ValueIndex>();
+    if (samples.empty()) return index;
+
+    auto [lowest, highest] = std::minmax_element(samples.begin(), samples.end());
+    const int64_t minVal = *lowest;
+    const int64_t span = static_cast<int64_t>(*highest) - minVal + 1;
+
+    if (span <= MAX_DENSE_SPAN) {
+        std::vector<uint64_t> counts(static_cast<size_t>(span), 0);
+        for (int v : samples) ++counts[static_cast<size_t>(v - minVal)];
+
+        uint64_t running = 0;
+        for (int64_t i = 0; i < span; ++i) {
+            if (counts[i] == 0) continue;
+            index->m_values.push_back(minVal + i);
+            index->m_prefix.push_back(running);
+            running += counts[i];
+        }
+        index->m_prefix.push_back(running);
+        return index;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    for (size_t i = 0; i < samples.size(); ++i) {
+        if (i == 0 || samples[i] != samples[i - 1]) {
+            index->m_values.push_back(samples[i]);
+            index->m_prefix.push_back(i);
+        }
+    }
+    index->m_prefix.push_back(samples.size());
+    return index;
+}
+
+std::shared_ptr<const ValueIndex> ValueIndex::FromCounts(const std::vector<int64_t>& values,
+                                                         const std::vector<uint64_t>& counts)
+{
+    auto index = std::make_shared<ValueIndex>();
+    if (values.size() != counts.size() || values.empty()) return index;
+    if (!std::is_sorted(values.begin(), values.end())) return index;
+
+    index->m_values = values;
+    index->m_prefix.reserve(counts.size() + 1);
+    uint64_t running = 0;
+    for (uint64_t c : counts) {
+        index->m_prefix.push_back(running);
+        running += c;
+    }
+    index->m_prefix.push_back(running);
+    return index;
+}
+
+uint64_t ValueIndex::CountInRange(double lo, double hi) const {
+    if (m_values.empty() || lo > hi) return 0;
+    // Compare as double, exactly like the converter's filter
+    auto first = std::partition_point(m_values.begin(), m_values.end(),
+                                      [lo](int64_t v) { return static_cast<double>(v) < lo; });
+    auto last = std::partition_point(first, m_values.end(),
+                                     [hi](int64_t v) { return static_cast<double>(v) <= hi; });
+    return m_prefix[last - m_values.begin()] - m_prefix[first - m_values.begin()];
+}
+
+std::vector<uint64_t> ValueIndex::BinCounts(int64_t start, int64_t width, int binCount) const {
+    std::vector<uint64_t> counts(std::max(0, binCount), 0);
+    if (m_values.empty() || width <= 0) return counts;
+
+    // Edges ascend, so each search only has to cover what is left of the index
+    auto it = std::lower_bound(m_values.begin(), m_values.end(), start);
+    uint64_t below = m_prefix[it - m_values.begin()];
+    for (int i = 0; i < binCount && it != m_values.end(); ++i) {
+        const int64_t edge = start + (i + 1) * width;
+        it = std::lower_bound(it, m_values.end(), edge);
+        const uint64_t next = m_prefix[it - m_values.begin()];
+        counts[i] = next - below;
+        below = next;
+    }
+    return counts;
+}
+
+std::vector<uint64_t> ValueIndex::Counts() const {
+    std::vector<uint64_t> counts(m_values.size());
+    for (size_t i = 0; i < counts.size(); ++i) counts[i] = m_prefix[i + 1] - m_prefix[i];
+    return counts;
+}
@@ -0,0 +1,41 @@
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Sorted distinct sample values with prefix-summed counts, built once per raw
+// file. Answers "how many samples lie in [lo, hi]" exactly with two binary
+// searches, using the same inclusive bounds as ConvertDecimalFile's region
+// filter. Size is proportional to the number of distinct values, not samples.
+class ValueIndex {
+private:
+    std::vector<int64_t> m_values;      // ascending, distinct
+    std::vector<uint64_t> m_prefix;     // m_prefix[i] = samples with value < m_values[i]; one extra total at the end
+
+public:
+    ValueIndex() = default;
+
+    // Reorders samples; each value is counted once per occurrence
+    static std::shared_ptr<const ValueIndex> FromSamples(std::vector<int>& samples);
+
+    // From parallel (value, count) arrays as written by Values()/Counts(); values must be ascending
+    static std::shared_ptr<const ValueIndex> FromCounts(const std::vector<int64_t>& values,
+                                                        const std::vector<uint64_t>& counts);
+
+    uint64_t CountInRange(double lo, double hi) const;
+
+    // Counts for binCount consecutive integer-aligned bins [start + i*width, start + (i+1)*width)
+    std::vector<uint64_t> BinCounts(int64_t start, int64_t width, int binCount) const;
+
+    uint64_t TotalCount() const { return m_prefix.empty() ? 0 : m_prefix.back(); }
+    size_t DistinctCount() const { return m_values.size(); }
+    bool Empty() const { return m_values.empty(); }
+    int64_t MinValue() const { return m_values.empty() ? 0 : m_values.front(); }
+    int64_t MaxValue() const { return m_values.empty() ? 0 : m_values.back(); }
+
+    const std::vector<int64_t>& Values() const { return m_values; }
+    std::vector<uint64_t> Counts() const;
+};
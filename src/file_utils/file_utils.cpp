@@ -1,5 +1,10 @@
 
 #include "file_utils.h"
+#include "../core/process_executor/process_executor.h"
+#include "../core/trace/trace.h"
+
+#include <algorithm>
+#include <fstream>
 
 void from_json(const json& j, Project& p) {
     j.at("vendor").get_to(p.vendor);
@@ -21,6 +26,8 @@ namespace Config {
     void from_json(const json& j, Config::AppConfig& c) {
         j.at("lastOpenedProject").get_to(c.lastOpenedProject);
         j.at("savedProjects").get_to(c.savedProjects);
+        if (j.contains("tools")) j.at("tools").get_to(c.tools);
+        c.toolJobs = static_cast<unsigned int>(std::max(0, j.value("toolJobs", 0)));
     }
 
     void to_json(json& j, const Config::AppConfig& c) {
@@ -31,90 +38,54 @@ namespace Config {
     }
 }
 
-std::optional<std::string> FileSelector(
-    const std::string& dialogKey,
-    const std::string& buttonLabel,
-    const std::string& fileFilters,
-    const std::string& initialPath,
-    const ImVec2& buttonSize,
-    const Config::ButtonPalette& buttonColor,
-    const ImVec4& textColor
-) {
-    ImGui::BeginGroup();
-    ImGui::PushFont(Config::fontH3);
-    ImGui::PushStyleColor(ImGuiCol_Button,        buttonColor.normal);
-    ImGui::PushStyleColor(ImGuiCol_ButtonHovered, buttonColor.hovered);
-    ImGui::PushStyleColor(ImGuiCol_ButtonActive,  buttonColor.active);
-    ImGui::PushStyleColor(ImGuiCol_Text, textColor);
-    {
-        std::string buttonLabelWithIcon = std::string(reinterpret_cast<const char*>(u8"\uf574")) + " " + buttonLabel;
-        if (ImGui::Button(buttonLabelWithIcon.c_str(), buttonSize)) {
-            ImGuiFileDialog::Instance()->OpenDialog(dialogKey.c_str(), "Select File", fileFilters.c_str());
-        }
-    }
-    ImGui::PopStyleColor(4);
-    ImGui::PopFont();
-    ImGui::EndGroup();
-
-    if (ImGuiFileDialog::Instance()->Display(dialogKey.c_str(), ImGuiWindowFlags_NoCollapse, ImVec2(600, 400))) {
-        if (ImGuiFileDialog::Instance()->IsOk()) {
-            std::string filePath = ImGuiFileDialog::Instance()->GetFilePathName();
-            ImGuiFileDialog::Instance()->Close();
-            return filePath;
-        }
-        ImGuiFileDialog::Instance()->Close();
-    }
-
-    return std::nullopt;
+// Every key is optional; missing ones keep the platform default
+void from_json(const json& j, ProcessLimits& l) {
+    l.wallSeconds = j.value("wallSeconds", l.wallSeconds);
+    l.cpuSeconds = j.value("cpuSeconds", l.cpuSeconds);
+    l.idleSeconds = j.value("idleSeconds", l.idleSeconds);
 }
 
-std::optional<fs::path> CopyFileToDirectory(const fs::path& sourcePath, const fs::path& destDir) {
-    try {
-        if (!fs::exists(sourcePath)) {
-            std::cerr << "Source file does not exist: " << sourcePath << "\n";
-            return std::nullopt;
-        }
-
-        fs::create_directories(destDir);
-
-        fs::path destPath = (destDir / sourcePath.filename()).make_preferred();
-        fs::copy_file(sourcePath, destPath, fs::copy_options::overwrite_existing);
-
-        return destPath;
-    } catch (const fs::filesystem_error& e) {
-        std::cerr << "Error copying file: " << e.what() << "\n";
-        return std::nullopt;
-    }
+void from_json(const json& j, ToolConfig& t) {
+    t.nonIid = j.value("nonIid", t.nonIid);
+    t.restart = j.value("restart", t.restart);
+    t.perl = j.value("perl", t.perl);
+    t.decimationScript = j.value("decimationScript", t.decimationScript);
+    t.useWsl = j.value("useWsl", t.useWsl);
+    t.wslDistro = j.value("wslDistro", t.wslDistro);
+    t.lineBuffer = j.value("lineBuffer", t.lineBuffer);
+    t.nonIidLimits = j.value("nonIidLimits", t.nonIidLimits);
+    t.restartLimits = j.value("restartLimits", t.restartLimits);
+    t.decimationLimits = j.value("decimationLimits", t.decimationLimits);
 }
 
-std::string toWslCommandPath(const std::filesystem::path& winPath) {
-    std::string path = winPath.string();
-    std::replace(path.begin(), path.end(), '\\', '/');
-
-    // handle drive letter
-    if (path.size() > 2 && path[1] == ':') {
-        char driveLetter = std::tolower(path[0]);
-        path = "/mnt/" + std::string(1, driveLetter) + path.substr(2);
+ProcessResult executeCommand(const std::vector<std::string>& argv, const ProcessOptions& options) {
+    ProcessResult result = ProcessExecutor::Shared().Run(argv, options);
+
+    // Lands on the tool span the caller opened, if tracing
+    Trace::Annotate("exitCode", result.exitCode);
+    Trace::Annotate("stop", ToString(result.stop));
+    Trace::Annotate("queuedSeconds", result.queuedSeconds);
+    Trace::Annotate("wallSeconds", result.wallSeconds);
+    Trace::Annotate("cpuSeconds", result.userSeconds + result.systemSeconds);
+    Trace::Annotate("peakRssMiB", static_cast<double>(result.maxRssBytes >> 20));
+
+    // A wrapper that could not run the tool exits like a tool that failed;
+    // report it as the failed launch it is
+    const ToolConfig tools = ToolConfig::Current();
+    const std::string* wrapped = tools.WrappedTool(argv);
+    if (wrapped && result.started && result.stop == ProcessStop::Exited && (result.exitCode == 126 || result.exitCode == 127)) {
+        result.started = false;
+        result.error = "could not run " + *wrapped + " (" + tools.lineBuffer + " exit code " + std::to_string(result.exitCode) + ")";
     }
 
-    // wrap in quotes for shell
-    return "\"" + path + "\"";
-}
-
-std::string executeCommand(const std::string& command) {
-    std::array<char, 128> buffer;
-    std::string result;
-    
-    std::unique_ptr<FILE, decltype(&_pclose)> pipe(_popen(command.c_str(), "r"), _pclose);
-    
-    if (!pipe) {
-        throw std::runtime_error("popen() failed!");
+    if (!result.started || result.stop != ProcessStop::Exited) {
+        const std::string tool = wrapped ? *wrapped : argv.empty() ? std::string() : argv.front();
+        std::cerr << "Command failed: " << tool << ": " << result.Summary() << "\n";
+        throw ProcessError(tool, std::move(result));
     }
-    
-    while (fgets(buffer.data(), buffer.size(), pipe.get()) != nullptr) {
-        result += buffer.data();
+    if (result.exitCode != 0) {
+        std::cerr << "Command exited with code " << result.exitCode << ": " << (wrapped ? *wrapped : argv.front()) << "\n";
     }
-    
     return result;
 }
 
@@ -3,7 +3,6 @@
 
 #include "../core/config.h"
 
-#include <ImGuiFileDialog.h>
 #include <nlohmann/json.hpp>
 using json = nlohmann::json;
 
@@ -14,24 +13,19 @@ namespace fs = std::filesystem;
 void from_json(const json& j, Project& p);
 void to_json(json& j, const Project& p);
 
+void from_json(const json& j, ProcessLimits& l);
+void from_json(const json& j, ToolConfig& t);
+
 namespace Config {
     void from_json(const json& j, Config::AppConfig& c);
     void to_json(json& j, const Config::AppConfig& c);
 }
 
-std::optional<std::string> FileSelector(
-    const std::string& dialogKey,       // Unique key for this dialog
-    const std::string& buttonLabel,     // Label for the button that opens dialog
-    const std::string& fileFilters = ".*", // e.g. ".txt,.bin"
-    const std::string& initialPath = ".",    // Start folder
-    const ImVec2& buttonSize = ImVec2(0, 0),
-    const Config::ButtonPalette& buttonColor = Config::GREY_BUTTON,
-    const ImVec4& textColor = Config::TEXT_DARK_CHARCOAL
-);
-
-std::optional<fs::path> CopyFileToDirectory(const fs::path& sourcePath, const fs::path& destDir);
-
-// WSL helpers
-std::string toWslCommandPath(const std::filesystem::path& winPath);
-std::string executeCommand(const std::string& command);
+// External tools: argv as built by ToolConfig::Command, run through
+// ProcessExecutor::Shared(); throws ProcessError if the tool cannot be
+// started (stdbuf failing to run it counts) or is stopped by its limits. A
+// tool that exits non-zero is returned as is: check Succeeded(). The result
+// (exit code, resources used, time queued) is also attached to the innermost
+// open trace span.
+ProcessResult executeCommand(const std::vector<std::string>& argv, const ProcessOptions& options = {});
 void writeStringToFile(const std::string& content, const std::filesystem::path& filePath);
\ No newline at end of file
@@ -0,0 +1,80 @@
+
+#include "file_selector.h"
+
+namespace {
+    // Dialog-opening button shared by the single and multi-file selectors
+    bool SelectorButton(const std::string& buttonLabel, const ImVec2& buttonSize,
+                        const Config::ButtonPalette& buttonColor, const ImVec4& textColor)
+    {
+        bool clicked = false;
+        ImGui::BeginGroup();
+        ImGui::PushFont(Config::fontH3);
+        ImGui::PushStyleColor(ImGuiCol_Button,        buttonColor.normal);
+        ImGui::PushStyleColor(ImGuiCol_ButtonHovered, buttonColor.hovered);
+        ImGui::PushStyleColor(ImGuiCol_ButtonActive,  buttonColor.active);
+        ImGui::PushStyleColor(ImGuiCol_Text, textColor);
+        {
+            std::string buttonLabelWithIcon = std::string(reinterpret_cast<const char*>(u8"\uf574")) + " " + buttonLabel;
+            clicked = ImGui::Button(buttonLabelWithIcon.c_str(), buttonSize);
+        }
+        ImGui::PopStyleColor(4);
+        ImGui::PopFont();
+        ImGui::EndGroup();
+        return clicked;
+    }
+}
+
+std::optional<std::string> FileSelector(
+    const std::string& dialogKey,
+    const std::string& buttonLabel,
+    const std::string& fileFilters,
+    const std::string& initialPath,
+    const ImVec2& buttonSize,
+    const Config::ButtonPalette& buttonColor,
+    const ImVec4& textColor
+) {
+    if (SelectorButton(buttonLabel, buttonSize, buttonColor, textColor)) {
+        ImGuiFileDialog::Instance()->OpenDialog(dialogKey.c_str(), "Select File", fileFilters.c_str());
+    }
+
+    if (ImGuiFileDialog::Instance()->Display(dialogKey.c_str(), ImGuiWindowFlags_NoCollapse, ImVec2(600, 400))) {
+        if (ImGuiFileDialog::Instance()->IsOk()) {
+            std::string filePath = ImGuiFileDialog::Instance()->GetFilePathName();
+            ImGuiFileDialog::Instance()->Close();
+            return filePath;
+        }
+        ImGuiFileDialog::Instance()->Close();
+    }
+
+    return std::nullopt;
+}
+
+std::optional<std::vector<std::string>> MultiFileSelector(
+    const std::string& dialogKey,
+    const std::string& buttonLabel,
+    const std::string& fileFilters,
+    const std::string& initialPath,
+    const ImVec2& buttonSize,
+    const Config::ButtonPalette& buttonColor,
+    const ImVec4& textColor
+) {
+    if (SelectorButton(buttonLabel, buttonSize, buttonColor, textColor)) {
+        IGFD::FileDialogConfig config;
+        config.path = initialPath;
+        config.countSelectionMax = 0;   // unlimited
+        ImGuiFileDialog::Instance()->OpenDialog(dialogKey.c_str(), "Select Files", fileFilters.c_str(), config);
+    }
+
+    if (ImGuiFileDialog::Instance()->Display(dialogKey.c_str(), ImGuiWindowFlags_NoCollapse, ImVec2(600, 400))) {
+        if (ImGuiFileDialog::Instance()->IsOk()) {
+            std::vector<std::string> filePaths;
+            for (const auto& [name, path] : ImGuiFileDialog::Instance()->GetSelection()) filePaths.push_back(path);
+            ImGuiFileDialog::Instance()->Close();
+            if (!filePaths.empty()) return filePaths;
+            return std::nullopt;
+        }
+        ImGuiFileDialog::Instance()->Close();
+    }
+
+    return std::nullopt;
+}
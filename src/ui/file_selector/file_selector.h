@@ -0,0 +1,31 @@
+
+#pragma once
+
+#include "../../core/config.h"
+
+#include <ImGuiFileDialog.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+std::optional<std::string> FileSelector(
+    const std::string& dialogKey,       // Unique key for this dialog
+    const std::string& buttonLabel,     // Label for the button that opens dialog
+    const std::string& fileFilters = ".*", // e.g. ".txt,.bin"
+    const std::string& initialPath = ".",    // Start folder
+    const ImVec2& buttonSize = ImVec2(0, 0),
+    const Config::ButtonPalette& buttonColor = Config::GREY_BUTTON,
+    const ImVec4& textColor = Config::TEXT_DARK_CHARCOAL
+);
+
+// Same as FileSelector, but the dialog accepts any number of files
+std::optional<std::vector<std::string>> MultiFileSelector(
+    const std::string& dialogKey,
+    const std::string& buttonLabel,
+    const std::string& fileFilters = ".*",
+    const std::string& initialPath = ".",
+    const ImVec2& buttonSize = ImVec2(0, 0),
+    const Config::ButtonPalette& buttonColor = Config::GREY_BUTTON,
+    const ImVec4& textColor = Config::TEXT_DARK_CHARCOAL
+);
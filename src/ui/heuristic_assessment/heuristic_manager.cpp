@@ -1,10 +1,27 @@
 
 #include "heuristic_manager.h"
+#include "../../data/sample_store/sample_store.h"
+#include "../../data/value_index/value_index.h"
 
 #include <algorithm>
 
 #include <lib90b/non_iid.h>
 
+namespace {
+    constexpr float VIEW_PIXELS_PER_BIN = 2.0f;     // resolution of the re-binned main plot
+
+    // Appended to a "Running" line: how far ea_non_iid has got
+    void RenderNonIidProgress(const NonIidProgress& progress) {
+        const NonIidReport report = progress.Snapshot();
+        ImGui::SameLine();
+        ImGui::TextDisabled("%zu/%zu estimators", report.estimates.size(), NON_IID_ESTIMATOR_COUNT);
+        if (const auto minimum = report.RunningMinimum()) {
+            ImGui::SameLine();
+            ImGui::TextDisabled("min so far %.6f", *minimum);
+        }
+    }
+}
+
 bool HeuristicManager::Initialize(DataManager* dataManager, Config::AppConfig* config, Project* project, UIState* uiState) {
     m_dataManager = dataManager;
     m_config = config;
@@ -14,6 +31,76 @@ bool HeuristicManager::Initialize(DataManager* dataManager, Config::AppConfig* c
     return true;
 }
 
+const HeuristicManager::MainPlotBuffers& HeuristicManager::RefreshMainPlot(const MainHistogram& hist) {
+    auto& plot = m_mainPlot;
+    if (plot.binsVersion == hist.binCounts.version() && plot.smoothedVersion == hist.smoothedCounts.version() &&
+        plot.minValue == hist.minValue && plot.binWidth == hist.binWidth) {
+        return plot;
+    }
+
+    plot.binsVersion = hist.binCounts.version();
+    plot.smoothedVersion = hist.smoothedCounts.version();
+    plot.minValue = hist.minValue;
+    plot.binWidth = hist.binWidth;
+    plot.hasData = std::any_of(hist.binCounts.begin(), hist.binCounts.end(), [](int c){ return c > 0; });
+
+    const int binCount = hist.binCount();
+    const bool hasSmoothed = hist.smoothedCounts.size() == hist.binCounts.size();
+    plot.xs.resize(binCount);
+    plot.ys.resize(binCount);
+    for (int i = 0; i < binCount; ++i) {
+        plot.xs[i] = hist.minValue + (i + 0.5) * hist.binWidth;
+        plot.ys[i] = hasSmoothed ? hist.smoothedCounts[i] : hist.binCounts[i];
+    }
+    return plot;
+}
+
+const HeuristicManager::SubPlotBuffers& HeuristicManager::RefreshSubPlot(size_t index, const MainHistogram& main, const SubHistogram& sub) {
+    if (m_subPlots.size() < main.subHists.size()) m_subPlots.resize(main.subHists.size());
+    auto& plot = m_subPlots[index];
+    if (plot.built && plot.binsVersion == main.binCounts.version() && plot.smoothedVersion == main.smoothedCounts.version() &&
+        plot.valueIndex == main.valueIndex && plot.minValue == main.minValue && plot.binWidth == main.binWidth &&
+        plot.rectMin == sub.rect.X.Min && plot.rectMax == sub.rect.X.Max) {
+        return plot;
+    }
+
+    plot.built = true;
+    plot.binsVersion = main.binCounts.version();
+    plot.smoothedVersion = main.smoothedCounts.version();
+    plot.valueIndex = main.valueIndex;
+    plot.minValue = main.minValue;
+    plot.binWidth = main.binWidth;
+    plot.rectMin = sub.rect.X.Min;
+    plot.rectMax = sub.rect.X.Max;
+
+    // Convert rect range to bin indexes
+    int binMin = static_cast<int>((sub.rect.X.Min - main.minValue) / main.binWidth);
+    int binMax = static_cast<int>((sub.rect.X.Max - main.minValue) / main.binWidth);
+    const int lastBin = std::max(0, main.binCount() - 1);
+    binMin = std::clamp(binMin, 0, lastBin);
+    binMax = std::clamp(binMax, 0, lastBin);
+    if (binMin > binMax) std::swap(binMin, binMax);
+    if (main.binCounts.empty()) binMax = binMin - 1;    // nothing computed yet
+    const bool hasSmoothed = main.smoothedCounts.size() == main.binCounts.size();
+
+    // Sub-histogram plot data comes from the main bins; statistics use the raw counts
+    plot.binCount = std::max(0, binMax - binMin + 1);
+    plot.xs.resize(plot.binCount);
+    plot.ys.resize(plot.binCount);
+    plot.sampleCount = 0;
+    for (int b = binMin; b <= binMax; ++b) {
+        plot.xs[b - binMin] = main.minValue + (b + 0.5) * main.binWidth;
+        plot.ys[b - binMin] = hasSmoothed ? main.smoothedCounts[b] : main.binCounts[b];
+        plot.sampleCount += main.binCounts[b];
+    }
+
+    // The value index counts the exact range the converter will keep; bins only
+    // approximate the edges, so they stand in until the index is available
+    plot.exactCount = main.valueIndex != nullptr;
+    if (plot.exactCount) plot.sampleCount = static_cast<long long>(main.valueIndex->CountInRange(sub.rect.X.Min, sub.rect.X.Max));
+    return plot;
+}
+
 // -----------------------------------------------------------------------------
 // Render - full refactor using MainHistogram::subHists (SubHistogram)
 // -----------------------------------------------------------------------------
@@ -155,7 +242,8 @@ void HeuristicManager::Render() {
                         &oe->heuristicData.mainHistogram.nonIidResultFilePath,
                         &oe->heuristicData.mainHistogram.nonIidResult,
                         &oe->heuristicData.mainHistogram.nonIidParsedResults,
-                        &oe->heuristicData.mainHistogram.testTimer
+                        &oe->heuristicData.mainHistogram.testTimer,
+                        &oe->heuristicData.mainHistogram.nonIidProgress
                     });
                 }
             }
@@ -208,23 +296,27 @@ void HeuristicManager::Render() {
 
         // Render main histogram (bars)
         auto& hist = oe->heuristicData.mainHistogram;
-        bool hasData = std::any_of(hist.binCounts.begin(), hist.binCounts.end(), [](int c){ return c > 0; });
+        const MainPlotBuffers& mainPlot = RefreshMainPlot(hist);
+        const bool hasData = mainPlot.hasData;
+
+        // With a value index the X axis is free to zoom and pan, and the bins follow it;
+        // without one (older projects) the precomputed bins are all there is
+        const bool zoomable = hasData && hist.valueIndex != nullptr;
 
         std::string plotLabel = "Main Histogram - " + oe->oeName;
         if (ImPlot::BeginPlot(plotLabel.c_str(), ImVec2(-1, 300))) {
-            ImPlot::SetupAxes("Value", "Frequency", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
-
-            if (hasData) {
-                static std::vector<double> xs, ys;
-                xs.resize(hist.binCount);
-                ys.resize(hist.binCount);
-
-                for (int i = 0; i < hist.binCount; ++i) {
-                    xs[i] = hist.minValue + (i + 0.5) * hist.binWidth;
-                    ys[i] = static_cast<double>(hist.binCounts[i]);
-                }
-
-                ImPlot::PlotBars("##MainHistogramSamples", xs.data(), ys.data(), hist.binCount, hist.binWidth);
+            ImPlot::SetupAxes("Value", "Frequency", zoomable ? ImPlotAxisFlags_None : ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+            if (zoomable) ImPlot::SetupAxisLimits(ImAxis_X1, hist.minValue, hist.maxValue, ImPlotCond_Once);
+
+            if (zoomable) {
+                const ImPlotRect limits = ImPlot::GetPlotLimits();
+                const int targetBins = std::max(1, static_cast<int>(ImPlot::GetPlotSize().x / VIEW_PIXELS_PER_BIN));
+                m_mainView.Update(hist, limits.X.Min, limits.X.Max, targetBins);
+                ImPlot::PlotBars("##MainHistogramSamples", m_mainView.Centers().data(), m_mainView.Heights().data(),
+                                 m_mainView.BinCount(), m_mainView.BinWidth());
+            } else if (hasData) {
+                ImPlot::PlotBars("##MainHistogramSamples", mainPlot.xs.data(), mainPlot.ys.data(),
+                                 static_cast<int>(mainPlot.xs.size()), hist.binWidth);
             }
 
             // Draw drag rects for sub-hists
@@ -242,9 +334,11 @@ void HeuristicManager::Render() {
                                  sub.color,
                                  ImPlotDragToolFlags_None);
 
-                // Clamp X to histogram min/max
-                rect.X.Min = std::max(rect.X.Min, static_cast<double>(hist.minValue));
-                rect.X.Max = std::min(rect.X.Max, static_cast<double>(hist.maxValue));
+                // Clamp X to the histogram range, or to the outermost samples once the tails are visible
+                const double lowest = zoomable ? static_cast<double>(hist.valueIndex->MinValue()) : hist.minValue;
+                const double highest = zoomable ? static_cast<double>(hist.valueIndex->MaxValue()) : hist.maxValue;
+                rect.X.Min = std::max(rect.X.Min, lowest);
+                rect.X.Max = std::min(rect.X.Max, highest);
 
                 if (rect.X.Min > rect.X.Max) std::swap(rect.X.Min, rect.X.Max);
             }
@@ -293,6 +387,7 @@ void HeuristicManager::Render() {
         } else if (hist.testTimer.testRunning) {
             float t = std::chrono::duration<float>(std::chrono::steady_clock::now() - hist.testTimer.testStartTime).count();
             ImGui::BulletText("Running tests %.1fs %c", t, "|/-\\"[static_cast<int>(t*4) % 4]);
+            RenderNonIidProgress(hist.nonIidProgress);
         } else {
             ImGui::BulletText("Non-IID results not available");
         }
@@ -328,22 +423,7 @@ void HeuristicManager::Render() {
         for (size_t i = 0; i < main.subHists.size(); ++i) {
             auto& sub = main.subHists[i];
 
-            // Convert rect range to bin indexes
-            int binMin = static_cast<int>((sub.rect.X.Min - main.minValue) / main.binWidth);
-            int binMax = static_cast<int>((sub.rect.X.Max - main.minValue) / main.binWidth);
-            binMin = std::clamp(binMin, 0, main.binCount - 1);
-            binMax = std::clamp(binMax, 0, main.binCount - 1);
-            if (binMin > binMax) std::swap(binMin, binMax);
-
-            // Prepare sub-histogram plot data (from main bins)
-            std::vector<double> xs, ys;
-            xs.reserve(binMax - binMin + 1);
-            ys.reserve(binMax - binMin + 1);
-            for (int b = binMin; b <= binMax; ++b) {
-                double xCenter = main.minValue + (b + 0.5) * main.binWidth;
-                xs.push_back(xCenter);
-                ys.push_back(static_cast<double>(main.binCounts[b]));
-            }
+            const SubPlotBuffers& subPlot = RefreshSubPlot(i, main, sub);
 
             // Each sub-histogram child
             std::string childLabel = "SubHistogramChild_" + std::to_string(i);
@@ -388,7 +468,8 @@ void HeuristicManager::Render() {
                                     &sub.nonIidResultFilePath,
                                     &sub.nonIidResult,
                                     &sub.nonIidParsedResults,
-                                    &sub.testTimer
+                                    &sub.testTimer,
+                                    &sub.nonIidProgress
                                 });
                             }
                         }
@@ -415,9 +496,17 @@ void HeuristicManager::Render() {
                     ImGui::BulletText("Min: %u", sub.minValue);
                     ImGui::BulletText("Max: %u", sub.maxValue);
 
-                    int subBinCount = std::max(0, binMax - binMin + 1);
-                    ImGui::BulletText("Bins: %d", subBinCount);
+                    ImGui::BulletText("Bins: %d", subPlot.binCount);
                     ImGui::BulletText("Bin Width: %.2f", main.binWidth);
+                    ImGui::Bullet();
+                    ImGui::SameLine();
+                    ImGui::TextColored(subPlot.sampleCount >= Config::MIN_REGION_SAMPLES ? Config::TEXT_GREEN : Config::TEXT_ORANGE,
+                                       subPlot.exactCount ? "Samples: %lld" : "Samples: ~%lld", subPlot.sampleCount);
+                    if (ImGui::IsItemHovered()) {
+                        ImGui::SetTooltip("%s; at least %lld are needed for a Non-IID run",
+                                          subPlot.exactCount ? "Exact count" : "Estimated from bins until the file is reprocessed",
+                                          Config::MIN_REGION_SAMPLES);
+                    }
 
                     ImGui::Separator();
                     ImGui::Text("%s Non-IID results:", regionTitle.c_str());
@@ -466,6 +555,7 @@ void HeuristicManager::Render() {
                     } else if (sub.testTimer.testRunning) {
                         float t = std::chrono::duration<float>(std::chrono::steady_clock::now() - sub.testTimer.testStartTime).count();
                         ImGui::BulletText("Running %.1fs %c", t, "|/-\\"[static_cast<int>(t*4) % 4]);
+                        RenderNonIidProgress(sub.nonIidProgress);
                     } else {
                         ImGui::BulletText("Non-IID results not available");
                     }
@@ -482,11 +572,11 @@ void HeuristicManager::Render() {
                     std::string plotLabel = "Sub-Histogram - " + regionTitle;
                     if (ImPlot::BeginPlot(plotLabel.c_str(), ImVec2(-1, -1))) {
                         ImPlot::SetupAxes("Value", "Frequency", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
-                        if (!xs.empty()) {
+                        if (!subPlot.xs.empty()) {
                             ImVec4 opaqueColor = sub.color;
                             opaqueColor.w = 1.0f;
                             ImPlot::SetNextFillStyle(opaqueColor);
-                            ImPlot::PlotBars("##SubHistogramSamples", xs.data(), ys.data(), (int)xs.size(), main.binWidth);
+                            ImPlot::PlotBars("##SubHistogramSamples", subPlot.xs.data(), subPlot.ys.data(), subPlot.binCount, main.binWidth);
                         }
                         ImPlot::EndPlot();
                     }
@@ -541,7 +631,7 @@ void HeuristicManager::RenderUploadSectionForOE(OperationalEnvironment* oe)
             // optional: show error
             ImGui::TextColored(ImVec4(1,0.3f,0.3f,1), "Failed to create dest dir: %s", ec.message().c_str());
         } else {
-            if (auto dest = CopyFileToDirectory(*file, destDir)) {
+            if (auto dest = ImportSampleFile(*file, m_currentProject->path, destDir)) {
                 oe->heuristicData.mainHistogram.heuristicFilePath = dest->string(); // success
             } else {
                 ImGui::TextColored(ImVec4(1,0.3f,0.3f,1), "Failed to copy file for %s", oe->oeName.c_str());
@@ -583,6 +673,15 @@ void HeuristicManager::RenderMainHistogramConfigPopup() {
         // File selection — store in mainHistogram
         RenderUploadSectionForOE(oe);
 
+        // Resolution used by the next "Process uploaded file"
+        {
+            auto& mainHist = oe->heuristicData.mainHistogram;
+            ImGui::SetNextItemWidth(150.0f);
+            if (ImGui::InputInt("Bins (0 = auto)", &mainHist.requestedBinCount, 100, 500)) {
+                mainHist.requestedBinCount = std::clamp(mainHist.requestedBinCount, 0, 65536);
+            }
+        }
+
         ImGui::PushStyleColor(ImGuiCol_Button,        Config::ORANGE_BUTTON.hovered);
         ImGui::PushStyleColor(ImGuiCol_ButtonHovered, Config::ORANGE_BUTTON.normal);
         ImGui::PushStyleColor(ImGuiCol_ButtonActive,  Config::ORANGE_BUTTON.active);
@@ -596,7 +695,7 @@ void HeuristicManager::RenderMainHistogramConfigPopup() {
         ImGui::PushFont(Config::normal);
         ImGui::Separator();
         ImGui::Text("Main Histogram Metadata:");
-        ImGui::BulletText("Bins: %d", oe->heuristicData.mainHistogram.binCount);
+        ImGui::BulletText("Bins: %d", oe->heuristicData.mainHistogram.binCount());
         ImGui::SameLine();
         ImGui::BulletText("Min: %d", oe->heuristicData.mainHistogram.minValue);
         ImGui::SameLine();
@@ -606,6 +705,31 @@ void HeuristicManager::RenderMainHistogramConfigPopup() {
         ImGui::PopFont();
         ImGui::Separator();
 
+        // Smoothing only affects the displayed curve; raw counts are kept, so this needs no re-ingest
+        {
+            auto& mainHist = oe->heuristicData.mainHistogram;
+            ImGui::Text("Display Smoothing:");
+
+            bool smoothingChanged = false;
+            static const char* kernelNames[] = { "Gaussian", "Box" };
+            int kernel = static_cast<int>(mainHist.smoothingKernel);
+            ImGui::SetNextItemWidth(150.0f);
+            if (ImGui::Combo("Kernel", &kernel, kernelNames, IM_ARRAYSIZE(kernelNames))) {
+                mainHist.smoothingKernel = static_cast<SmoothingKernel>(kernel);
+                smoothingChanged = true;
+            }
+
+            float sigma = static_cast<float>(mainHist.smoothingSigma);
+            ImGui::SetNextItemWidth(150.0f);
+            if (ImGui::SliderFloat("Sigma (bins)", &sigma, 0.0f, 5.0f, sigma > 0.0f ? "%.2f" : "off")) {
+                mainHist.smoothingSigma = sigma;
+                smoothingChanged = true;
+            }
+
+            if (smoothingChanged) smoothHistogram(mainHist);
+            ImGui::Separator();
+        }
+
         // Cancel button
         ImGui::PushFont(Config::fontH3);
         ImGui::PushStyleColor(ImGuiCol_Button,        Config::GREY_BUTTON.normal);
@@ -750,7 +874,8 @@ void HeuristicManager::RenderBatchHeuristic() {
                             &oe.heuristicData.mainHistogram.nonIidResultFilePath,
                             &oe.heuristicData.mainHistogram.nonIidResult,
                             &oe.heuristicData.mainHistogram.nonIidParsedResults,
-                            &oe.heuristicData.mainHistogram.testTimer
+                            &oe.heuristicData.mainHistogram.testTimer,
+                            &oe.heuristicData.mainHistogram.nonIidProgress
                         });
                     }
                 }
@@ -5,9 +5,11 @@
 
 #include "../../data/data_manager.h"
 #include "../../data/histogram/histogram.h"
+#include "../../data/histogram_view/histogram_view.h"
 #include "../../core/types.h"
 #include "../../core/app_command/app_command.h"
 #include "../../file_utils/file_utils.h"
+#include "../file_selector/file_selector.h"
 
 using CommandCallback = std::function<void(AppCommand)>;
 using NotificationCallback = std::function<void(const std::string&, float, ImVec4)>;
@@ -26,6 +28,44 @@ private:
 
     bool m_editHistogramPopupOpen = false;
 
+    // Main plot bins for the visible X range, rebuilt as the user zooms and pans
+    HistogramView m_mainView;
+
+    // Plot data derived from the main bins. Each buffer remembers the bin versions
+    // (and region bounds) it was built from, so steady frames reuse it untouched.
+    struct MainPlotBuffers {
+        uint64_t binsVersion = 0;
+        uint64_t smoothedVersion = 0;
+        unsigned int minValue = 0;
+        double binWidth = 0.0;
+        bool hasData = false;
+        std::vector<double> xs;
+        std::vector<double> ys;
+    };
+
+    struct SubPlotBuffers {
+        bool built = false;
+        uint64_t binsVersion = 0;
+        uint64_t smoothedVersion = 0;
+        std::shared_ptr<const ValueIndex> valueIndex;
+        unsigned int minValue = 0;
+        double binWidth = 0.0;
+        double rectMin = 0.0;
+        double rectMax = 0.0;
+
+        int binCount = 0;
+        long long sampleCount = 0;
+        bool exactCount = false;
+        std::vector<double> xs;
+        std::vector<double> ys;
+    };
+
+    MainPlotBuffers m_mainPlot;
+    std::vector<SubPlotBuffers> m_subPlots;     // by position in subHists
+
+    const MainPlotBuffers& RefreshMainPlot(const MainHistogram& hist);
+    const SubPlotBuffers& RefreshSubPlot(size_t index, const MainHistogram& main, const SubHistogram& sub);
+
     void StartHistogramProcessing(const fs::path& filePath);
 
     // Popups
@@ -44,6 +84,8 @@ public:
     bool m_showBatchPopup = false;
     void RenderBatchHeuristic();
 
+    void OpenEditHistogramPopup() { m_editHistogramPopupOpen = true; }
+
     void SetCommandCallback(CommandCallback cb) { m_onCommand = cb; };
     void SetNotificationCallback(NotificationCallback cb) { m_onNotification = cb; }
 
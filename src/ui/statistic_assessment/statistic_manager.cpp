@@ -4,6 +4,7 @@
 
 #include "statistic_manager.h"
 #include "../../file_utils/file_utils.h"
+#include "../../data/sample_store/sample_store.h"
 
 bool StatisticManager::Initialize(DataManager* dataManager, Config::AppConfig* config, Project* project, UIState* uiState) {
     m_dataManager = dataManager;
@@ -14,6 +15,44 @@ bool StatisticManager::Initialize(DataManager* dataManager, Config::AppConfig* c
     return true;
 }
 
+const NonIidReport& StatisticManager::RefreshProgress(const NonIidProgress& progress) {
+    const uint64_t version = progress.Version();
+    if (version != m_progressVersion) {
+        m_progress = progress.Snapshot();
+        m_progressVersion = version;
+    }
+    return m_progress;
+}
+
+void StatisticManager::RenderEstimatorTable(const NonIidReport& report) {
+    if (report.estimates.empty()) return;
+    if (!ImGui::CollapsingHeader("Estimators")) return;
+
+    const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+    const ImVec2 size(0.0f, rowHeight * (std::min(report.estimates.size(), NON_IID_ESTIMATOR_COUNT) + 1.5f));
+    if (!ImGui::BeginTable("##estimators", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp | ImGuiTableFlags_ScrollY, size)) return;
+
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("Estimator", ImGuiTableColumnFlags_WidthStretch, 3.0f);
+    ImGui::TableSetupColumn("Original", ImGuiTableColumnFlags_WidthStretch, 1.0f);
+    ImGui::TableSetupColumn("Bitstring", ImGuiTableColumnFlags_WidthStretch, 1.0f);
+    ImGui::TableHeadersRow();
+
+    auto valueCell = [](const std::optional<double>& value) {
+        ImGui::TableNextColumn();
+        if (value) ImGui::Text("%.6f", *value);
+        else ImGui::TextDisabled("-");
+    };
+    for (const auto& estimate : report.estimates) {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(estimate.name.c_str());
+        valueCell(estimate.original);
+        valueCell(estimate.bitstring);
+    }
+    ImGui::EndTable();
+}
+
 // Render
 void StatisticManager::Render() {
     if (!m_currentProject) return;
@@ -64,7 +103,8 @@ void StatisticManager::Render() {
                         &oe->statisticData.nonIidResultFilePath,
                         &oe->statisticData.nonIidResult,
                         &oe->statisticData.nonIidParsedResults,
-                        &oe->statisticData.nonIidTestTimer
+                        &oe->statisticData.nonIidTestTimer,
+                        &oe->statisticData.nonIidProgress
                     });
                 }
             }
@@ -73,26 +113,26 @@ void StatisticManager::Render() {
         ImGui::PopStyleColor(4);
         ImGui::PopFont();
 
+        const NonIidReport& progress = RefreshProgress(oe->statisticData.nonIidProgress);
         if (oe->statisticData.nonIidTestTimer.testRunning) {
             ImGui::SameLine();
             ImGui::PushFont(Config::normal);
             float t = std::chrono::duration<float>(std::chrono::steady_clock::now() - oe->statisticData.nonIidTestTimer.testStartTime).count();
             ImGui::Text("Running test %.1fs %c", t, "|/-\\"[static_cast<int>(t*4) % 4]);
+            ImGui::SameLine();
+            ImGui::TextDisabled("%zu/%zu estimators", progress.estimates.size(), NON_IID_ESTIMATOR_COUNT);
+            if (const auto minimum = progress.RunningMinimum()) {
+                ImGui::SameLine();
+                ImGui::TextDisabled("min so far %.6f", *minimum);
+            }
             ImGui::PopFont();
         }
 
         ImGui::Dummy(ImVec2(0.0f, 2 * ImGui::GetStyle().ItemSpacing.y));
 
-        std::string resultText = (oe->statisticData.nonIidResult == "") ? "No Result Yet" : oe->statisticData.nonIidResult;
-
         ImGui::PushFont(Config::normal);
-        ImGui::InputTextMultiline(
-            "##readonly_text",                      // Label
-            const_cast<char*>(resultText.c_str()),  // ImGui requires a non-const char*
-            resultText.size() + 1,                  // Buffer size
-            ImGui::GetContentRegionAvail(),         // Size (Takes remaining height of child)
-            ImGuiInputTextFlags_ReadOnly            // Make it read-only
-        );
+        RenderEstimatorTable(progress);
+        m_nonIidViewer.Render("##readonly_text", oe->statisticData.nonIidResult);
         ImGui::PopFont();
     }
     ImGui::EndChild();
@@ -156,16 +196,8 @@ void StatisticManager::Render() {
 
         ImGui::Dummy(ImVec2(0.0f, 2 * ImGui::GetStyle().ItemSpacing.y));
 
-        std::string resultText = (oe->statisticData.restartResult == "") ? "No Result Yet" : oe->statisticData.restartResult;
-
         ImGui::PushFont(Config::normal);
-        ImGui::InputTextMultiline(
-            "##readonly_text",                      // Label
-            const_cast<char*>(resultText.c_str()),  // ImGui requires a non-const char*
-            resultText.size() + 1,                  // Buffer size
-            ImGui::GetContentRegionAvail(),         // Size (Takes remaining height of child)
-            ImGuiInputTextFlags_ReadOnly            // Make it read-only
-        );
+        m_restartViewer.Render("##readonly_text", oe->statisticData.restartResult);
         ImGui::PopFont();
     }
     ImGui::EndChild();
@@ -207,7 +239,7 @@ void StatisticManager::RenderUploadSectionForOE(
         if (ec) {
             ImGui::TextColored(ImVec4(1,0.3f,0.3f,1), "Failed to create dest dir: %s", ec.message().c_str());
         } else {
-            if (auto dest = CopyFileToDirectory(*file, destDir)) {
+            if (auto dest = ImportSampleFile(*file, m_currentProject->path, destDir)) {
                 filePathVar = dest->string();
             } else {
                 ImGui::TextColored(ImVec4(1,0.3f,0.3f,1), "Failed to copy file for %s", oe->oeName.c_str());
@@ -348,7 +380,8 @@ void StatisticManager::RenderBatchStatistic() {
                             &oe.statisticData.nonIidResultFilePath,
                             &oe.statisticData.nonIidResult,
                             &oe.statisticData.nonIidParsedResults,
-                            &oe.statisticData.nonIidTestTimer
+                            &oe.statisticData.nonIidTestTimer,
+                            &oe.statisticData.nonIidProgress
                         });
                     }
                 }
@@ -7,6 +7,8 @@
 #include "../../core/types.h"
 #include "../../core/app_command/app_command.h"
 #include "../../file_utils/file_utils.h"
+#include "../file_selector/file_selector.h"
+#include "../text_viewer/text_viewer.h"
 
 using CommandCallback = std::function<void(AppCommand)>;
 using NotificationCallback = std::function<void(const std::string&, float, ImVec4)>;
@@ -31,6 +33,10 @@ private:
     StatisticTabs nonIidTab = StatisticTabs::Summary;
     StatisticTabs restartTab = StatisticTabs::Summary;
 
+    // Full tool output of the selected OE
+    TextViewer m_nonIidViewer;
+    TextViewer m_restartViewer;
+
     //void RenderUploadSectionForOE(OperationalEnvironment* oe);
     void RenderUploadSectionForOE(
         OperationalEnvironment* oe,
@@ -42,6 +48,14 @@ private:
         const ImVec4& textColor = Config::TEXT_DARK_CHARCOAL
     );
 
+    // Per-estimator results of the current or last ea_non_iid run, copied
+    // from the selected OE only when its progress version changes
+    NonIidReport m_progress;
+    uint64_t m_progressVersion = 0;
+
+    const NonIidReport& RefreshProgress(const NonIidProgress& progress);
+    void RenderEstimatorTable(const NonIidReport& report);
+
     // Popups
     void RenderPopups();
 
@@ -56,6 +70,8 @@ public:
     bool m_showBatchPopup = false;
     void RenderBatchStatistic();
 
+    bool IsBusy() const { return m_nonIidViewer.Busy() || m_restartViewer.Busy(); }
+
     void SetCommandCallback(CommandCallback cb) { m_onCommand = cb; };
     void SetNotificationCallback(NotificationCallback cb) { m_onNotification = cb; }
 
@@ -0,0 +1,254 @@
+
+#include "text_viewer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+    // Jobs check their cancel flag once per chunk, so an abandoned job stops quickly
+    constexpr size_t CANCEL_CHUNK = 1 << 20;
+    constexpr size_t MAX_MATCHES = 100'000;
+    // Longer lines are cut when drawn; Copy All still has the full text
+    constexpr size_t MAX_LINE_BYTES = 4096;
+
+    template<typename T>
+    bool JobReady(const std::future<T>& job) {
+        return job.valid() && job.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    template<typename T>
+    void Abandon(std::future<T>& job, const std::shared_ptr<std::atomic<bool>>& cancel) {
+        if (cancel) cancel->store(true, std::memory_order_relaxed);
+        if (job.valid()) job.wait();
+        job = {};
+    }
+
+    char Lower(char c) {
+        return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+}
+
+TextViewer::~TextViewer() {
+    Abandon(m_indexJob, m_indexCancel);
+    Abandon(m_searchJob, m_searchCancel);
+}
+
+void TextViewer::SetText(const SharedText& text) {
+    if (text.shared() == m_text) return;
+
+    Abandon(m_indexJob, m_indexCancel);
+    Abandon(m_searchJob, m_searchCancel);
+
+    m_text = text.shared();
+    m_index = {};
+    m_indexed = false;
+    m_widthFont = nullptr;
+    m_matches.clear();
+    m_currentMatch = -1;
+    m_searchedQuery.clear();     // re-run the current query against the new text
+    if (!m_text) return;
+
+    m_indexCancel = std::make_shared<std::atomic<bool>>(false);
+    m_indexJob = std::async(std::launch::async, [text = m_text, cancel = m_indexCancel] {
+        LineIndex index;
+        index.starts.push_back(0);
+        size_t longest = 0;
+
+        const char* data = text->data();
+        const size_t size = text->size();
+        size_t pos = 0;
+        while (pos < size) {
+            if (cancel->load(std::memory_order_relaxed)) return LineIndex{};
+            const size_t chunkEnd = std::min(size, pos + CANCEL_CHUNK);
+            while (pos < chunkEnd) {
+                const void* nl = std::memchr(data + pos, '\n', chunkEnd - pos);
+                if (!nl) { pos = chunkEnd; break; }
+                pos = static_cast<size_t>(static_cast<const char*>(nl) - data) + 1;
+                const size_t length = pos - index.starts.back();
+                if (length > longest) { longest = length; index.longestLine = index.starts.size() - 1; }
+                index.starts.push_back(pos);
+            }
+        }
+        if (size - index.starts.back() > longest) index.longestLine = index.starts.size() - 1;
+        return index;
+    });
+}
+
+void TextViewer::Poll() {
+    if (JobReady(m_indexJob)) {
+        m_index = m_indexJob.get();
+        m_indexed = true;
+    }
+    if (JobReady(m_searchJob)) {
+        m_matches = m_searchJob.get();
+        m_currentMatch = m_matches.empty() ? -1 : 0;
+        m_scrollToMatch = !m_matches.empty();
+    }
+}
+
+void TextViewer::StartSearch() {
+    Abandon(m_searchJob, m_searchCancel);
+
+    m_searchedQuery = m_query;
+    m_matches.clear();
+    m_currentMatch = -1;
+    if (!m_text || m_searchedQuery.empty()) return;
+
+    m_searchCancel = std::make_shared<std::atomic<bool>>(false);
+    m_searchJob = std::async(std::launch::async, [text = m_text, query = m_searchedQuery, cancel = m_searchCancel] {
+        // ASCII case-insensitive; tool output is plain ASCII
+        std::vector<size_t> matches;
+        const std::string& haystack = *text;
+        const size_t n = query.size();
+        if (haystack.size() < n) return matches;
+
+        const char first = Lower(query[0]);
+        const size_t last = haystack.size() - n;
+        for (size_t pos = 0; pos <= last; ++pos) {
+            if ((pos & (CANCEL_CHUNK - 1)) == 0 && cancel->load(std::memory_order_relaxed)) return std::vector<size_t>{};
+            if (Lower(haystack[pos]) != first) continue;
+
+            size_t i = 1;
+            while (i < n && Lower(haystack[pos + i]) == Lower(query[i])) ++i;
+            if (i == n) {
+                matches.push_back(pos);
+                if (matches.size() >= MAX_MATCHES) break;
+                pos += n - 1;
+            }
+        }
+        return matches;
+    });
+}
+
+void TextViewer::StepMatch(int direction) {
+    if (m_matches.empty()) return;
+    const int count = static_cast<int>(m_matches.size());
+    m_currentMatch = ((m_currentMatch + direction) % count + count) % count;
+    m_scrollToMatch = true;
+}
+
+// [begin, end) of a line as drawn: without its terminator, cut at MAX_LINE_BYTES
+std::pair<size_t, size_t> TextViewer::LineRange(size_t line) const {
+    const size_t begin = m_index.starts[line];
+    size_t end = line + 1 < m_index.starts.size() ? m_index.starts[line + 1] : m_text->size();
+    const std::string& text = *m_text;
+    if (end > begin && text[end - 1] == '\n') --end;
+    if (end > begin && text[end - 1] == '\r') --end;
+    return { begin, std::min(end, begin + MAX_LINE_BYTES) };
+}
+
+size_t TextViewer::LineOf(size_t offset) const {
+    auto it = std::upper_bound(m_index.starts.begin(), m_index.starts.end(), offset);
+    return static_cast<size_t>(it - m_index.starts.begin()) - 1;
+}
+
+void TextViewer::Render(const char* id, const SharedText& text, const ImVec2& size, const char* placeholder) {
+    SetText(text);
+    Poll();
+
+    ImGui::PushID(id);
+    RenderSearchBar();
+    RenderLines(size, placeholder);
+    ImGui::PopID();
+}
+
+void TextViewer::RenderSearchBar() {
+    const float buttonWidth = ImGui::GetFrameHeight();
+    const float countWidth = ImGui::CalcTextSize("000000 / 000000").x;
+    const float spacing = ImGui::GetStyle().ItemSpacing.x;
+
+    ImGui::SetNextItemWidth(std::max(100.0f, ImGui::GetContentRegionAvail().x - countWidth - 2 * buttonWidth - 3 * spacing));
+    if (ImGui::InputTextWithHint("##find", "Find", m_query, sizeof(m_query), ImGuiInputTextFlags_EnterReturnsTrue)) {
+        // Enter steps to the next match once the query has been searched
+        if (m_searchedQuery == m_query) StepMatch(+1);
+        ImGui::SetKeyboardFocusHere(-1);
+    }
+    if (m_searchedQuery != m_query) StartSearch();
+
+    ImGui::SameLine();
+    ImGui::BeginDisabled(m_matches.empty());
+    if (ImGui::ArrowButton("##prev", ImGuiDir_Up)) StepMatch(-1);
+    ImGui::SameLine();
+    if (ImGui::ArrowButton("##next", ImGuiDir_Down)) StepMatch(+1);
+    ImGui::EndDisabled();
+
+    ImGui::SameLine();
+    char count[48];
+    if (m_searchJob.valid()) std::snprintf(count, sizeof(count), "...");
+    else if (m_searchedQuery.empty()) count[0] = '\0';
+    else if (m_matches.empty()) std::snprintf(count, sizeof(count), "No matches");
+    else std::snprintf(count, sizeof(count), "%d / %zu%s", m_currentMatch + 1, m_matches.size(),
+                       m_matches.size() >= MAX_MATCHES ? "+" : "");
+    ImGui::AlignTextToFramePadding();
+    ImGui::TextUnformatted(count);
+}
+
+void TextViewer::RenderLines(const ImVec2& size, const char* placeholder) {
+    // Measure the widest line once per font so the horizontal scrollbar stays stable
+    if (m_indexed && m_widthFont != ImGui::GetFont()) {
+        const auto [begin, end] = LineRange(m_index.longestLine);
+        m_contentWidth = ImGui::CalcTextSize(m_text->data() + begin, m_text->data() + end).x
+                       + ImGui::GetStyle().WindowPadding.x * 2;
+        m_widthFont = ImGui::GetFont();
+    }
+    if (m_indexed) ImGui::SetNextWindowContentSize(ImVec2(m_contentWidth, 0.0f));
+
+    ImGui::PushStyleColor(ImGuiCol_ChildBg, ImGui::GetStyleColorVec4(ImGuiCol_FrameBg));
+    ImGui::BeginChild("##lines", size, true, ImGuiWindowFlags_HorizontalScrollbar);
+
+    if (!m_text) {
+        ImGui::TextDisabled("%s", placeholder);
+    } else if (!m_indexed) {
+        ImGui::TextDisabled("Indexing %.1f MB...", m_text->size() / (1024.0 * 1024.0));
+    } else {
+        const char* data = m_text->data();
+        const float lineHeight = ImGui::GetTextLineHeightWithSpacing();
+
+        size_t currentOffset = 0;
+        if (m_currentMatch >= 0) currentOffset = m_matches[m_currentMatch];
+        if (m_scrollToMatch && m_currentMatch >= 0) {
+            const size_t line = LineOf(currentOffset);
+            const float prefix = ImGui::CalcTextSize(data + m_index.starts[line], data + currentOffset).x;
+            ImGui::SetScrollY(std::max(0.0f, line * lineHeight - ImGui::GetWindowHeight() * 0.5f));
+            ImGui::SetScrollX(std::max(0.0f, prefix - ImGui::GetWindowWidth() * 0.5f));
+            m_scrollToMatch = false;
+        }
+
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+        const ImU32 matchColor = ImGui::GetColorU32(ImGuiCol_TextSelectedBg);
+        const ImU32 currentColor = ImGui::ColorConvertFloat4ToU32(ImVec4(1.0f, 0.75f, 0.2f, 0.6f));
+        const size_t queryLength = m_searchedQuery.size();
+
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(m_index.starts.size()), lineHeight);
+        while (clipper.Step()) {
+            for (int line = clipper.DisplayStart; line < clipper.DisplayEnd; ++line) {
+                const auto [begin, end] = LineRange(static_cast<size_t>(line));
+                const ImVec2 origin = ImGui::GetCursorScreenPos();
+
+                // Highlight matches that start on this line
+                auto it = std::lower_bound(m_matches.begin(), m_matches.end(), begin);
+                for (; it != m_matches.end() && *it < end; ++it) {
+                    const size_t matchEnd = std::min(*it + queryLength, end);
+                    const float x0 = ImGui::CalcTextSize(data + begin, data + *it).x;
+                    const float x1 = x0 + ImGui::CalcTextSize(data + *it, data + matchEnd).x;
+                    drawList->AddRectFilled(ImVec2(origin.x + x0, origin.y), ImVec2(origin.x + x1, origin.y + ImGui::GetTextLineHeight()),
+                                            *it == currentOffset && m_currentMatch >= 0 ? currentColor : matchColor);
+                }
+                ImGui::TextUnformatted(data + begin, data + end);
+            }
+        }
+        clipper.End();
+    }
+
+    if (m_text && ImGui::BeginPopupContextWindow("##context")) {
+        if (ImGui::MenuItem("Copy All")) ImGui::SetClipboardText(m_text->c_str());
+        ImGui::EndPopup();
+    }
+
+    ImGui::EndChild();
+    ImGui::PopStyleColor();
+}
@@ -0,0 +1,66 @@
+
+#pragma once
+
+#include <imgui.h>
+
+#include "../../core/shared_text/shared_text.h"
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Read-only viewer for tool output that can run to megabytes (ea_non_iid -v).
+// The line offset table is built on a background thread, and only the lines
+// inside the scroll window are submitted each frame. Search also runs in the
+// background; matches are highlighted and can be stepped through.
+class TextViewer {
+private:
+    struct LineIndex {
+        std::vector<size_t> starts;     // byte offset of each line
+        size_t longestLine = 0;         // index of the line with the most bytes
+    };
+
+    std::shared_ptr<const std::string> m_text;
+
+    std::future<LineIndex> m_indexJob;
+    std::shared_ptr<std::atomic<bool>> m_indexCancel;
+    LineIndex m_index;
+    bool m_indexed = false;
+    float m_contentWidth = 0.0f;
+    const ImFont* m_widthFont = nullptr;  // font m_contentWidth was measured with
+
+    char m_query[128] = {};
+    std::string m_searchedQuery;
+    std::future<std::vector<size_t>> m_searchJob;
+    std::shared_ptr<std::atomic<bool>> m_searchCancel;
+    std::vector<size_t> m_matches;      // byte offsets of matches, ascending
+    int m_currentMatch = -1;
+    bool m_scrollToMatch = false;
+
+    void SetText(const SharedText& text);
+    void Poll();
+    void StartSearch();
+    void StepMatch(int direction);
+
+    std::pair<size_t, size_t> LineRange(size_t line) const;
+    size_t LineOf(size_t offset) const;
+
+    void RenderSearchBar();
+    void RenderLines(const ImVec2& size, const char* placeholder);
+
+public:
+    TextViewer() = default;
+    ~TextViewer();
+
+    TextViewer(const TextViewer&) = delete;
+    TextViewer& operator=(const TextViewer&) = delete;
+
+    // Draws a search bar and, below it, the text in a child of the given size (0 = fill)
+    void Render(const char* id, const SharedText& text, const ImVec2& size = ImVec2(0, 0),
+                const char* placeholder = "No Result Yet");
+
+    // True while indexing or searching, so the caller keeps frames coming
+    bool Busy() const { return m_indexJob.valid() || m_searchJob.valid(); }
+};
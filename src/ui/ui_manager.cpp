@@ -1,4 +1,7 @@
 
+#include <algorithm>
+#include <cstdio>
+
 #include <imgui.h>
 
 #include "ui_manager.h"
@@ -586,32 +589,45 @@ LoadProjectFormResult UIManager::RenderLoadProjectPopup() {
 
     static bool projectSelected = false;
     static std::string selectedPath;
+    static char searchBuffer[128] = "";
 
     ImGui::PushFont(Config::normal);
     if (ImGui::BeginPopupModal("Load Project", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
-        ImGui::Text("Select a Project:");
-
-        // Build vendor → repo → project hierarchy
-        std::map<std::string, std::map<std::string, std::vector<int>>> projectHierarchy;
-        for (int i = 0; i < m_config->savedProjects.size(); ++i) {
-            const auto& proj = m_config->savedProjects[i];
-            projectHierarchy[proj.vendor][proj.repo].push_back(i);
-        }
+        const auto& catalog = m_config->savedProjects;
+        const auto& stats = catalog.Stats();
 
-        // Render tree view
-        for (auto& [vendor, repos] : projectHierarchy) {
-            if (ImGui::TreeNode(vendor.c_str())) {
-                for (auto& [repo, indices] : repos) {
-                    if (ImGui::TreeNode(repo.c_str())) {
-                        for (int i : indices) {
-                            const auto& proj = m_config->savedProjects[i];
+        ImGui::Text("Select a Project:");
+        ImGui::TextColored(Config::TEXT_MUTED_GREY, "%zu projects, %zu vendors, %zu repos, %zu OEs",
+                           stats.projectCount, stats.vendorCount, stats.repoCount, stats.oeCount);
+
+        ImGui::SetNextItemWidth(300.0f);
+        ImGui::InputTextWithHint("##projectSearch", "Search vendor, repo or project...", searchBuffer, IM_ARRAYSIZE(searchBuffer));
+
+        // Vendor -> repo -> project grouping is cached by the catalog per query
+        const auto& view = catalog.Search(searchBuffer);
+        const auto& entries = catalog.Entries();
+        bool filtering = searchBuffer[0] != '\0';
+
+        ImGui::BeginChild("ProjectCatalog", ImVec2(400.0f, 300.0f), true);
+        for (const auto& vendor : view.vendors) {
+            const auto& vendorName = entries[view.matches[vendor.begin]].vendor;
+            if (filtering) ImGui::SetNextItemOpen(true, ImGuiCond_Always);
+            if (ImGui::TreeNode(vendorName.c_str())) {
+                for (const auto& repo : vendor.repos) {
+                    const auto& repoName = entries[view.matches[repo.begin]].repo;
+                    if (filtering) ImGui::SetNextItemOpen(true, ImGuiCond_Always);
+                    if (ImGui::TreeNode(repoName.c_str())) {
+                        for (size_t m = repo.begin; m < repo.end; ++m) {
+                            const auto& proj = entries[view.matches[m]];
+                            ImGui::PushID(view.matches[m]);
                             if (ImGui::Selectable(proj.name.c_str())) {
                                 projectSelected = true;
                                 selectedPath = proj.path + "\\project.json";
                             }
+                            ImGui::PopID();
 
                             if (ImGui::IsItemHovered())
-                                ImGui::SetTooltip("%s", proj.path.c_str());
+                                ImGui::SetTooltip("%s (%d OEs)", proj.path.c_str(), proj.oeCount);
                         }
                         ImGui::TreePop();
                     }
@@ -619,6 +635,10 @@ LoadProjectFormResult UIManager::RenderLoadProjectPopup() {
                 ImGui::TreePop();
             }
         }
+        if (view.matches.empty()) {
+            ImGui::TextColored(Config::TEXT_MUTED_GREY, filtering ? "No matching projects" : "No saved projects");
+        }
+        ImGui::EndChild();
 
         ImGuiSpacing(1);
         ImGui::Separator();
@@ -877,14 +897,12 @@ EditOEFormResult UIManager::RenderEditOEPopup() {
 }
 
 void UIManager::RenderJentFileConverterPopup() {
-    static std::filesystem::path inputFilePath;
-    static bool conversionDone = false;
-    static std::string statusMessage;
-
     const ImVec2 buttonSize = ImVec2(150, 35);
     const auto& buttonPalette = Config::GREEN_BUTTON;
     const ImVec4 textColor = ImVec4(1, 1, 1, 1);
 
+    const bool converting = m_conversionJob && !m_conversionJob->Finished();
+
     if (uiState.showFileConverterPopup)
         ImGui::OpenPopup("JENT File Converter");
 
@@ -898,83 +916,134 @@ void UIManager::RenderJentFileConverterPopup() {
         ImGui::PopFont();
         ImGui::Spacing();
 
-        // --- Input File ---
+        // --- Input Files ---
         ImGui::PushFont(Config::fontH2_Bold);
-        ImGui::Text("Input File:");
+        ImGui::Text("Input Files:");
         ImGui::PopFont();
 
-        if (auto file = FileSelector(
+        ImGui::BeginDisabled(converting);
+        if (auto files = MultiFileSelector(
             "SelectJENTInputDlg",
-            "Select Input",
+            "Add Files",
             "All Files (*.*){.*}",
             ".",
             buttonSize,
             buttonPalette,
             textColor))
         {
-            inputFilePath = *file;
-            conversionDone = false;
-            statusMessage.clear();
+            for (const auto& file : *files) {
+                if (std::find(m_converterInputs.begin(), m_converterInputs.end(), file) == m_converterInputs.end())
+                    m_converterInputs.emplace_back(file);
+            }
         }
+        ImGui::EndDisabled();
 
-        if (!inputFilePath.empty()) {
-            ImGui::TextWrapped("%s", inputFilePath.string().c_str());
-        } else {
-            ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), "No input file selected");
+        if (!m_converterInputs.empty()) {
+            ImGui::SameLine();
+            if (ImGui::Button("Clear", ImVec2(80, 0))) m_converterInputs.clear();
+
+            const float listHeight = std::min(6.0f, static_cast<float>(m_converterInputs.size())) * ImGui::GetTextLineHeightWithSpacing()
+                                   + ImGui::GetStyle().WindowPadding.y * 2;
+            ImGui::BeginChild("##converter_inputs", ImVec2(600, listHeight), true);
+            for (const auto& file : m_converterInputs) ImGui::TextUnformatted(file.string().c_str());
+            ImGui::EndChild();
+        } else if (!m_conversionJob) {
+            ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), "No input files selected");
         }
 
         ImGui::Spacing();
         ImGui::Separator();
         ImGui::Spacing();
 
-        // --- Convert Button ---
-        bool canConvert = !inputFilePath.empty();
-        if (!canConvert)
-            ImGui::BeginDisabled();
-
-        if (ImGui::Button("Convert", ImVec2(120, 0))) {
-            std::filesystem::path outputFilePath = inputFilePath;
-            outputFilePath.replace_extension(".bin");
-
-            bool ok = m_dataManager->ConvertDecimalFile(inputFilePath, outputFilePath);
-            conversionDone = true;
-
-            if (ok) {
-                statusMessage = "Conversion successful!\nSaved to: " + outputFilePath.string();
-            } else {
-                statusMessage = "Conversion failed.";
-            }
+        // --- Convert / Cancel Buttons ---
+        ImGui::BeginDisabled(m_converterInputs.empty() || converting);
+        const std::string convertLabel = m_converterInputs.size() > 1
+            ? "Convert " + std::to_string(m_converterInputs.size()) + " Files"
+            : std::string("Convert");
+        if (ImGui::Button(convertLabel.c_str(), ImVec2(160, 0))) {
+            // Runs on the pool; this popup only watches the job and may be closed meanwhile
+            m_conversionJob = std::make_shared<ConversionJob>(m_converterInputs);
+            m_converterInputs.clear();
+            commandQueue.Push(AppCommand(ConvertFilesCommand{ m_conversionJob }));
         }
+        ImGui::EndDisabled();
 
-        if (!canConvert)
+        if (converting) {
+            ImGui::SameLine();
+            ImGui::BeginDisabled(m_conversionJob->Cancelled());
+            if (ImGui::Button("Cancel", ImVec2(120, 0))) m_conversionJob->Cancel();
             ImGui::EndDisabled();
+        }
 
         ImGui::Spacing();
 
-        // --- Status Message ---
-        if (conversionDone) {
-            ImVec4 color = statusMessage.starts_with("Conversion successful!")
-                ? ImVec4(0.2f, 0.9f, 0.2f, 1.0f)
-                : ImVec4(0.9f, 0.2f, 0.2f, 1.0f);
-            ImGui::TextColored(color, "%s", statusMessage.c_str());
+        // --- Progress ---
+        if (m_conversionJob) {
+            const ConversionJob& job = *m_conversionJob;
+            const double mb = 1024.0 * 1024.0;
+            const uint64_t total = job.TotalBytes();
+            const uint64_t read = job.BytesRead();
+
+            char overlay[96];
+            std::snprintf(overlay, sizeof(overlay), "%.1f / %.1f MB", read / mb, total / mb);
+            ImGui::ProgressBar(total ? static_cast<float>(std::min(1.0, static_cast<double>(read) / total)) : (job.Finished() ? 1.0f : 0.0f),
+                               ImVec2(600, 0), overlay);
+            ImGui::Text("%zu of %zu files finished  |  %.1f MB/s  |  %.1fs",
+                        job.FinishedCount(), job.Size(), job.BytesPerSecond() / mb, job.ElapsedSeconds());
+
+            if (ImGui::BeginTable("##conversion_files", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp | ImGuiTableFlags_ScrollY,
+                                  ImVec2(600, std::min(8.0f, static_cast<float>(job.Size()) + 1.0f) * ImGui::GetFrameHeightWithSpacing())))
+            {
+                ImGui::TableSetupScrollFreeze(0, 1);
+                ImGui::TableSetupColumn("File", ImGuiTableColumnFlags_WidthStretch, 2.0f);
+                ImGui::TableSetupColumn("Progress", ImGuiTableColumnFlags_WidthStretch, 1.0f);
+                ImGui::TableSetupColumn("Status", ImGuiTableColumnFlags_WidthStretch, 2.0f);
+                ImGui::TableHeadersRow();
+
+                for (size_t i = 0; i < job.Size(); ++i) {
+                    const FileConversion& file = job.File(i);
+                    const ConversionState state = file.state.load(std::memory_order_acquire);
+                    const uint64_t fileRead = file.progress.bytesRead.load(std::memory_order_relaxed);
+
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(file.input.filename().string().c_str());
+                    if (ImGui::IsItemHovered()) ImGui::SetTooltip("%s", file.input.string().c_str());
+
+                    ImGui::TableNextColumn();
+                    const float fraction = state == ConversionState::Done ? 1.0f
+                        : file.totalBytes ? static_cast<float>(std::min(1.0, static_cast<double>(fileRead) / file.totalBytes)) : 0.0f;
+                    ImGui::ProgressBar(fraction, ImVec2(-FLT_MIN, 0), "");
+
+                    ImGui::TableNextColumn();
+                    switch (state) {
+                        case ConversionState::Queued:    ImGui::TextDisabled("Queued"); break;
+                        case ConversionState::Running:   ImGui::TextUnformatted("Converting..."); break;
+                        case ConversionState::Done:      ImGui::TextColored(ImVec4(0.2f, 0.9f, 0.2f, 1.0f), "Saved %s", file.output.filename().string().c_str()); break;
+                        case ConversionState::Failed:    ImGui::TextColored(ImVec4(0.9f, 0.2f, 0.2f, 1.0f), "%s", file.error.c_str()); break;
+                        case ConversionState::Cancelled: ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.0f, 1.0f), "Cancelled"); break;
+                    }
+                }
+                ImGui::EndTable();
+            }
         }
 
         ImGui::Spacing();
         ImGui::Separator();
         ImGui::Spacing();
 
-        // --- Cancel Button ---
+        // --- Close Button ---
         ImGui::PushFont(Config::fontH3);
         ImGui::PushStyleColor(ImGuiCol_Button,        Config::GREY_BUTTON.normal);
         ImGui::PushStyleColor(ImGuiCol_ButtonHovered, Config::GREY_BUTTON.hovered);
         ImGui::PushStyleColor(ImGuiCol_ButtonActive,  Config::GREY_BUTTON.active);
         ImGui::PushStyleColor(ImGuiCol_Text, Config::TEXT_DARK_CHARCOAL);
         if (ImGui::Button((std::string(reinterpret_cast<const char*>(u8"\uf00d")) + " Close").c_str(), ImVec2(120, 0))) {
+            // A running conversion carries on in the background and reports when done
             ImGui::CloseCurrentPopup();
             uiState.showFileConverterPopup = false;
-            inputFilePath.clear();
-            conversionDone = false;
-            statusMessage.clear();
+            m_converterInputs.clear();
+            if (!converting) m_conversionJob.reset();
         }
         ImGui::PopStyleColor(4);
         ImGui::PopFont();
@@ -991,7 +1060,7 @@ void UIManager::ImGuiSpacing(int count) {
 }
 
 // Utility
-void UIManager::OnProjectChanged(Project project) {
+void UIManager::OnProjectChanged(const Project& project) {
     if (!project.operationalEnvironments.empty()) {
         uiState.selectedOEIndex = 0;
     } else {
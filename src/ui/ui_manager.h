@@ -23,6 +23,10 @@ private:
     StatisticManager statisticManager;
     HeuristicManager heuristicManager;
 
+    // JENT file converter: files picked for the next run, and the latest run
+    std::vector<fs::path> m_converterInputs;
+    std::shared_ptr<ConversionJob> m_conversionJob;
+
     // Main Content
     void RenderMainWindow();
     void RenderSidebar();
@@ -55,8 +59,19 @@ public:
     void Render();
 
     // Utility
-    void OnProjectChanged(Project project);
+    void OnProjectChanged(const Project& project);
+
+    // True while something on screen changes without input (notifications, background work)
+    bool IsAnimating() const {
+        return !notifications.empty() || uiState.showSaveNotification || statisticManager.IsBusy()
+            || (m_conversionJob && !m_conversionJob->Finished());
+    }
 
     // Notifications
     void PushNotification(const std::string& msg, float duration = 3.0f, ImVec4 color = ImVec4(1,1,1,1));
+
+    // Headless drivers (the UI frame benchmark) open tabs and popups through these
+    UIState& GetUIState() { return uiState; }
+    StatisticManager& GetStatisticManager() { return statisticManager; }
+    HeuristicManager& GetHeuristicManager() { return heuristicManager; }
 };
\ No newline at end of file
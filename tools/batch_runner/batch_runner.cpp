@@ -0,0 +1,395 @@
+
+// Headless batch runner: loads a project.json, runs the selected pipeline
+// stages for all (or some) OEs on a thread pool, and writes results back.
+//
+//   EntropyAnalysisBatch <project.json> [--stages a,b,...] [--oe name,...] [--threads N]
+//                        [--tool-jobs N] [--tools FILE] [--trace FILE]
+//
+// Stages run in dependency order with a barrier between phases:
+//   1. histogram                                  (convert + bin the raw samples)
+//   2. noniid, regions, decimation, statistic     (all OEs in parallel)
+//   3. restart                                    (needs the statistic min-entropy)
+//
+// --tool-jobs caps how many external tools (ea_non_iid, ea_restart, perl) run at
+// once; pipeline workers beyond that wait for a slot. --tools reads tool
+// locations from a JSON file shaped like the "tools" entry of app.json, e.g.
+//   { "nonIid": "/opt/90b/ea_non_iid", "restart": "/opt/90b/ea_restart",
+//     "nonIidLimits": { "wallSeconds": 7200, "cpuSeconds": 7200 } }
+// A tool that exceeds its limits is stopped and its stage counted as failed;
+// its partial output and the limit it hit go to its result file. Every tool
+// run that did not succeed (not started, stopped, or a non-zero exit) fails
+// its stage and is listed again after the stage totals.
+// Each tool run is logged with its exit code, wall and CPU time, peak memory
+// and time spent waiting for a tool slot.
+//
+// --trace writes a Chrome trace (chrome://tracing, ui.perfetto.dev) of every
+// pipeline span, tagged with OE and region.
+
+#include "../../src/core/command_executor/command_executor.h"
+#include "../../src/core/process_executor/process_executor.h"
+#include "../../src/core/thread_pool/thread_pool.h"
+#include "../../src/core/trace/trace.h"
+#include "../../src/data/data_manager.h"
+#include "../../src/file_utils/file_utils.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    const std::vector<std::string> ALL_STAGES = {
+        "histogram", "noniid", "regions", "decimation", "statistic", "restart"
+    };
+
+    struct Options {
+        std::string projectFile;
+        std::set<std::string> stages;
+        std::set<std::string> oeNames;
+        unsigned int threads = 0;
+        unsigned int toolJobs = 0;
+        std::string toolsFile;
+        std::string traceFile;
+    };
+
+    struct StageTally {
+        std::atomic<int> succeeded{0};
+        std::atomic<int> failed{0};
+    };
+
+    // A tool that did not start, was stopped by a watchdog limit or exited non-zero
+    struct StoppedTool {
+        std::string oe;
+        std::string tool;
+        std::string summary;            // reason, limit hit and resources used
+        size_t partialBytes = 0;        // output kept in the tool's result file
+        std::string lastLine;           // of that output, to show how far it got
+    };
+
+    std::string LastLine(const std::string& text) {
+        size_t end = text.find_last_not_of("\r\n");
+        if (end == std::string::npos) return {};
+        size_t start = text.rfind('\n', end);
+        start = (start == std::string::npos) ? 0 : start + 1;
+        return text.substr(start, end - start + 1);
+    }
+
+    std::mutex logMutex;
+
+    // Set by the tool-run callback when a run on this worker did not succeed;
+    // the stage it belongs to is then counted as failed
+    thread_local bool toolFailed = false;
+
+    void Log(const std::string& message) {
+        std::lock_guard<std::mutex> lock(logMutex);
+        std::cout << message << std::endl;
+    }
+
+    std::vector<std::string> SplitList(const std::string& list) {
+        std::vector<std::string> items;
+        std::stringstream stream(list);
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            if (!item.empty()) items.push_back(item);
+        }
+        return items;
+    }
+
+    void PrintUsage(const char* argv0) {
+        std::cerr << "Usage: " << argv0 << " <project.json> [--stages a,b,...] [--oe name,...] [--threads N] [--tool-jobs N] [--tools FILE] [--trace FILE]\n"
+                  << "  stages: histogram, noniid, regions, decimation, statistic, restart, all (default: all)\n"
+                  << "  oe:     OE names to process (default: every OE in the project)\n"
+                  << "  threads: worker count (default: hardware concurrency)\n"
+                  << "  tool-jobs: external tools running at once (default: half the hardware threads)\n"
+                  << "  tools:  JSON file with tool locations (default: tools on PATH)\n"
+                  << "  trace:  write a Chrome trace JSON of the run to FILE\n";
+    }
+
+    bool ParseArgs(int argc, char** argv, Options& opts) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto next = [&]() -> const char* { return (i + 1 < argc) ? argv[++i] : nullptr; };
+
+            if (arg == "--stages") {
+                const char* value = next();
+                if (!value) return false;
+                for (auto& stage : SplitList(value)) {
+                    if (stage == "all") {
+                        opts.stages.insert(ALL_STAGES.begin(), ALL_STAGES.end());
+                    } else if (std::find(ALL_STAGES.begin(), ALL_STAGES.end(), stage) != ALL_STAGES.end()) {
+                        opts.stages.insert(stage);
+                    } else {
+                        std::cerr << "Unknown stage: " << stage << "\n";
+                        return false;
+                    }
+                }
+            } else if (arg == "--oe") {
+                const char* value = next();
+                if (!value) return false;
+                for (auto& name : SplitList(value)) opts.oeNames.insert(name);
+            } else if (arg == "--threads") {
+                const char* value = next();
+                if (!value) return false;
+                int threads = std::atoi(value);
+                if (threads <= 0) {
+                    std::cerr << "--threads must be positive\n";
+                    return false;
+                }
+                opts.threads = static_cast<unsigned int>(threads);
+            } else if (arg == "--tool-jobs") {
+                const char* value = next();
+                if (!value) return false;
+                int toolJobs = std::atoi(value);
+                if (toolJobs <= 0) {
+                    std::cerr << "--tool-jobs must be positive\n";
+                    return false;
+                }
+                opts.toolJobs = static_cast<unsigned int>(toolJobs);
+            } else if (arg == "--tools") {
+                const char* value = next();
+                if (!value) return false;
+                opts.toolsFile = value;
+            } else if (arg == "--trace") {
+                const char* value = next();
+                if (!value) return false;
+                opts.traceFile = value;
+            } else if (arg == "-h" || arg == "--help") {
+                return false;
+            } else if (opts.projectFile.empty() && arg.rfind("--", 0) != 0) {
+                opts.projectFile = arg;
+            } else {
+                std::cerr << "Unknown argument: " << arg << "\n";
+                return false;
+            }
+        }
+
+        if (opts.projectFile.empty()) return false;
+        if (opts.stages.empty()) opts.stages.insert(ALL_STAGES.begin(), ALL_STAGES.end());
+        if (opts.threads == 0) opts.threads = std::max(1u, std::thread::hardware_concurrency());
+        if (opts.toolJobs == 0) opts.toolJobs = static_cast<unsigned int>(ProcessExecutor::DefaultConcurrency());
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opts;
+    if (!ParseArgs(argc, argv, opts)) {
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    if (!opts.traceFile.empty()) {
+        Trace::SetEnabled(true);
+        Trace::SetThreadName("main");
+    }
+
+    if (!opts.toolsFile.empty()) {
+        std::ifstream in(opts.toolsFile);
+        if (!in.is_open()) {
+            std::cerr << "Failed to open tools file: " << opts.toolsFile << "\n";
+            return 1;
+        }
+        try {
+            ToolConfig::SetCurrent(nlohmann::json::parse(in).get<ToolConfig>());
+        } catch (const nlohmann::json::exception& e) {
+            std::cerr << "Failed to parse tools file: " << e.what() << "\n";
+            return 1;
+        }
+    }
+
+    DataManager dataManager;
+    Project project = dataManager.LoadProject(opts.projectFile);
+    if (project.name.empty()) {
+        std::cerr << "Failed to load project: " << opts.projectFile << "\n";
+        return 1;
+    }
+
+    std::vector<int> selected;
+    for (int i = 0; i < static_cast<int>(project.operationalEnvironments.size()); ++i) {
+        if (opts.oeNames.empty() || opts.oeNames.count(project.operationalEnvironments[i].oeName)) {
+            selected.push_back(i);
+        }
+    }
+    if (selected.empty()) {
+        std::cerr << "No matching operational environments in " << opts.projectFile << "\n";
+        return 1;
+    }
+
+    Log("Project " + project.vendor + "/" + project.repo + "/" + project.name + ": "
+        + std::to_string(selected.size()) + " OE(s), " + std::to_string(opts.threads) + " thread(s), "
+        + std::to_string(opts.toolJobs) + " tool job(s)");
+    ProcessExecutor::Shared().SetMaxConcurrent(opts.toolJobs);
+
+    // One executor per OE so every message carries the OE it belongs to
+    std::map<int, std::unique_ptr<CommandExecutor>> executors;
+    std::mutex stoppedMutex;
+    std::vector<StoppedTool> stopped;
+    for (int i : selected) {
+        const std::string& oeName = project.operationalEnvironments[i].oeName;
+        std::string prefix = "[" + oeName + "] ";
+        executors[i] = std::make_unique<CommandExecutor>(dataManager,
+            [prefix](const std::string& msg, float, ImVec4) { Log(prefix + msg); });
+        executors[i]->SetToolRunCallback([&, prefix, oeName](const std::string& tool, const ProcessResult& result) {
+            Log(prefix + tool + ": " + result.Summary());
+            if (result.Succeeded()) return;
+            toolFailed = true;
+            std::lock_guard<std::mutex> lock(stoppedMutex);
+            stopped.push_back({ oeName, tool, result.Summary(), result.output.size(), LastLine(result.output) });
+        });
+    }
+
+    std::map<std::string, StageTally> tally;
+    for (auto& stage : ALL_STAGES) tally[stage];
+
+    auto wants = [&](const std::string& stage) { return opts.stages.count(stage) > 0; };
+
+    {
+        ThreadPool pool(opts.threads);
+        std::vector<std::future<void>> phase;
+
+        auto submit = [&](const std::string& stage, int oeIndex, std::function<bool()> work) {
+            const std::string& oeName = project.operationalEnvironments[oeIndex].oeName;
+            phase.push_back(pool.Enqueue([&tally, stage, oeName, work = std::move(work)] {
+                Trace::ContextScope traceContext(oeName);
+                toolFailed = false;
+                const bool succeeded = work();
+                if (succeeded && !toolFailed) tally.at(stage).succeeded++;
+                else tally.at(stage).failed++;
+            }));
+        };
+        auto barrier = [&] {
+            for (auto& f : phase) f.get();
+            phase.clear();
+        };
+
+        // Phase 1
+        if (wants("histogram")) {
+            for (int i : selected) {
+                if (project.operationalEnvironments[i].heuristicData.mainHistogram.heuristicFilePath.empty()) continue;
+                CommandExecutor* executor = executors[i].get();
+                submit("histogram", i, [executor, &project, i] {
+                    return executor->ProcessHistogram(project, ProcessHistogramCommand{ i });
+                });
+            }
+            barrier();
+        }
+
+        // Phase 2
+        for (int i : selected) {
+            OperationalEnvironment* oe = &project.operationalEnvironments[i];
+            MainHistogram* mainHist = &oe->heuristicData.mainHistogram;
+            CommandExecutor* executor = executors[i].get();
+
+            if (wants("noniid") && !mainHist->convertedFilePath.empty()) {
+                submit("noniid", i, [executor, mainHist] {
+                    return executor->RunNonIidTest(RunNonIidTestCommand{
+                        mainHist->convertedFilePath,
+                        &mainHist->nonIidResultFilePath,
+                        &mainHist->nonIidResult,
+                        &mainHist->nonIidParsedResults,
+                        &mainHist->testTimer,
+                        &mainHist->nonIidProgress
+                    });
+                });
+            }
+
+            if (wants("regions") && !mainHist->heuristicFilePath.empty()) {
+                for (auto& region : mainHist->subHists) {
+                    SubHistogram* sub = &region;
+                    submit("regions", i, [executor, mainHist, sub, i] {
+                        return executor->ConvertAndRunNonIidTest(ConvertAndRunNonIidTestCommand{
+                            i,
+                            sub->subHistIndex,
+                            mainHist->heuristicFilePath,
+                            &sub->nonIidSampleFilePath,
+                            sub->rect.X.Min,
+                            sub->rect.X.Max,
+                            &sub->nonIidResultFilePath,
+                            &sub->nonIidResult,
+                            &sub->nonIidParsedResults,
+                            &sub->testTimer,
+                            &sub->nonIidProgress
+                        });
+                    });
+                }
+            }
+
+            if (wants("decimation") && !mainHist->convertedFilePath.empty()) {
+                submit("decimation", i, [executor, mainHist, &project, i] {
+                    return executor->FindPassingDecimation(project, FindPassingDecimationCommand{
+                        i,
+                        mainHist->convertedFilePath,
+                        std::make_shared<std::string>(),
+                        &mainHist->decimationTestTimer
+                    });
+                });
+            }
+
+            if (wants("statistic") && !oe->statisticData.nonIidSampleFilePath.empty()) {
+                StatisticData* stats = &oe->statisticData;
+                submit("statistic", i, [executor, stats] {
+                    return executor->RunNonIidTest(RunNonIidTestCommand{
+                        stats->nonIidSampleFilePath,
+                        &stats->nonIidResultFilePath,
+                        &stats->nonIidResult,
+                        &stats->nonIidParsedResults,
+                        &stats->nonIidTestTimer,
+                        &stats->nonIidProgress
+                    });
+                });
+            }
+        }
+        barrier();
+
+        // Phase 3
+        if (wants("restart")) {
+            for (int i : selected) {
+                StatisticData* stats = &project.operationalEnvironments[i].statisticData;
+                CommandExecutor* executor = executors[i].get();
+                if (stats->restartSampleFilePath.empty()) continue;
+                submit("restart", i, [executor, stats] {
+                    return executor->RunRestartTest(RunRestartTestCommand{
+                        stats->nonIidParsedResults.minEntropy,
+                        stats->restartSampleFilePath,
+                        &stats->restartResultFilePath,
+                        &stats->restartResult,
+                        &stats->restartTestTimer
+                    });
+                });
+            }
+            barrier();
+        }
+    }
+
+    bool saved = dataManager.WriteProjectFiles(project);
+    if (!saved) std::cerr << "Failed to write results back to " << opts.projectFile << "\n";
+
+    if (!opts.traceFile.empty() && Trace::WriteChromeTrace(opts.traceFile)) {
+        Log("Trace written to " + opts.traceFile);
+    }
+
+    int failures = 0;
+    for (auto& stage : ALL_STAGES) {
+        if (!wants(stage)) continue;
+        int ok = tally[stage].succeeded, bad = tally[stage].failed;
+        failures += bad;
+        Log(stage + ": " + std::to_string(ok) + " succeeded, " + std::to_string(bad) + " failed");
+    }
+    for (const auto& tool : stopped) {
+        Log("[" + tool.oe + "] " + tool.tool + " " + tool.summary + "; " + std::to_string(tool.partialBytes)
+            + " bytes of output kept" + (tool.lastLine.empty() ? "" : ", last line: " + tool.lastLine));
+    }
+
+    return (failures == 0 && saved) ? 0 : 1;
+}
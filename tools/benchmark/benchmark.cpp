@@ -0,0 +1,509 @@
+
+// Benchmarks for the ingest, parsing, conversion, histogram and persistence hot paths.
+//
+//   EntropyAnalysisBenchmark [--samples N[k|M|G],...] [--threads T,T,...|max] [--oes N]
+//                            [--tasks N] [--logs N] [--repeat R] [--workdir DIR]
+//                            [--out results.json] [--baseline baseline.json] [--threshold 0.10]
+//
+// Every case is run --repeat times and the median wall time is reported. Results
+// are written as JSON; with --baseline each case is compared by name against a
+// previous results file and the run fails (exit 1) if any case got slower than
+// baseline * (1 + threshold).
+
+#include "../../src/core/thread_pool/thread_pool.h"
+#include "../../src/data/data_manager.h"
+#include "../../src/data/decimal_parser/decimal_parser.h"
+#include "../../src/data/histogram/histogram.h"
+#include "../../src/data/result_parser/result_parser.h"
+#include "../../src/data/sample_generator/sample_generator.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace {
+    struct Options {
+        std::vector<uint64_t> samples = { 1'000'000, 10'000'000 };
+        std::vector<unsigned int> threads;
+        int oes = 64;
+        int tasks = 200'000;
+        int logs = 500;         // stored tool logs re-parsed per result_parse case
+        int repeat = 5;
+        double threshold = 0.10;
+        fs::path workDir = fs::temp_directory_path() / "eat_benchmark";
+        fs::path outFile;
+        fs::path baselineFile;
+    };
+
+    struct Result {
+        std::string name;
+        double seconds = 0.0;   // median wall time
+        uint64_t bytes = 0;     // input bytes, when the case is throughput-bound
+        uint64_t items = 0;     // samples / tasks / OEs processed per run
+    };
+
+    std::vector<std::string> SplitList(const std::string& list) {
+        std::vector<std::string> items;
+        std::stringstream stream(list);
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            if (!item.empty()) items.push_back(item);
+        }
+        return items;
+    }
+
+    bool ParseArgs(int argc, char** argv, Options& opts) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            auto take = [&]() { ++i; return std::string(value); };
+
+            if (arg == "-h" || arg == "--help") return false;
+            if (!value) {
+                std::cerr << "Missing value for " << arg << "\n";
+                return false;
+            }
+
+            try {
+                if (arg == "--samples") {
+                    opts.samples.clear();
+                    for (auto& s : SplitList(take())) {
+                        uint64_t count = 0;
+                        if (!ParseCount(s, count)) throw std::invalid_argument(s);
+                        opts.samples.push_back(count);
+                    }
+                } else if (arg == "--threads") {
+                    opts.threads.clear();
+                    for (auto& s : SplitList(take())) {
+                        uint64_t threads = 0;
+                        if (s == "max") threads = std::max(1u, std::thread::hardware_concurrency());
+                        else if (!ParseCount(s, threads) || threads > 4096) throw std::invalid_argument(s);
+                        opts.threads.push_back(static_cast<unsigned int>(threads));
+                    }
+                } else if (arg == "--oes") {
+                    opts.oes = std::stoi(take());
+                } else if (arg == "--tasks") {
+                    opts.tasks = std::stoi(take());
+                } else if (arg == "--logs") {
+                    opts.logs = std::max(1, std::stoi(take()));
+                } else if (arg == "--repeat") {
+                    opts.repeat = std::max(1, std::stoi(take()));
+                } else if (arg == "--workdir") {
+                    opts.workDir = take();
+                } else if (arg == "--out") {
+                    opts.outFile = take();
+                } else if (arg == "--baseline") {
+                    opts.baselineFile = take();
+                } else if (arg == "--threshold") {
+                    opts.threshold = std::stod(take());
+                } else {
+                    std::cerr << "Unknown argument: " << arg << "\n";
+                    return false;
+                }
+            } catch (const std::exception&) {
+                std::cerr << "Invalid value for " << arg << ": " << value << "\n";
+                return false;
+            }
+        }
+
+        if (opts.samples.empty()) return false;
+        if (opts.threads.empty()) {
+            unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+            for (unsigned int t = 1; t < maxThreads; t *= 2) opts.threads.push_back(t);
+            opts.threads.push_back(maxThreads);
+        }
+        return true;
+    }
+
+    void PrintUsage(const char* argv0) {
+        std::cerr << "Usage: " << argv0 << " [--samples N[k|M|G],...] [--threads T,...|max] [--oes N] [--tasks N] [--logs N]\n"
+                  << "       [--repeat R] [--workdir DIR] [--out FILE] [--baseline FILE] [--threshold F]\n";
+    }
+
+    double Median(std::vector<double> values) {
+        std::sort(values.begin(), values.end());
+        size_t mid = values.size() / 2;
+        return (values.size() % 2) ? values[mid] : 0.5 * (values[mid - 1] + values[mid]);
+    }
+
+    // Times fn() `repeat` times; setup() runs untimed before each repetition
+    double TimeMedian(int repeat, const std::function<void()>& fn, const std::function<void()>& setup = {}) {
+        std::vector<double> samples;
+        for (int r = 0; r < repeat; ++r) {
+            if (setup) setup();
+            auto start = std::chrono::steady_clock::now();
+            fn();
+            auto end = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration<double>(end - start).count());
+        }
+        return Median(samples);
+    }
+
+    Project MakeProject(const fs::path& root, int oeCount) {
+        Project project;
+        project.vendor = "bench";
+        project.repo = "bench";
+        project.name = "bench";
+        project.path = root.string();
+
+        for (int i = 0; i < oeCount; ++i) {
+            OperationalEnvironment oe;
+            oe.oeName = "OE_" + std::to_string(i);
+            oe.oePath = "OE/" + oe.oeName;
+            fs::create_directories(root / oe.oePath);
+
+            auto& mainHist = oe.heuristicData.mainHistogram;
+            mainHist.heuristicFilePath = (root / oe.oePath / "samples.txt").string();
+            mainHist.convertedFilePath = (root / oe.oePath / "samples.bin").string();
+            mainHist.minValue = 4000;
+            mainHist.maxValue = 6000;
+            mainHist.binWidth = 2000.0 / MainHistogram::defaultBinCount;
+            std::vector<int> bins(MainHistogram::defaultBinCount);
+            for (int b = 0; b < MainHistogram::defaultBinCount; ++b) bins[b] = (b * 7919 + i) % 100000;
+            mainHist.binCounts = std::move(bins);
+            mainHist.nonIidParsedResults.minEntropy = 0.5;
+            mainHist.firstPassingDecimationResult = "Passed: Found passing decimation rate: 4";
+            mainHist.nonIidResult = std::string(256 << 10, 'x');   // tool output is typically this large
+            oe.statisticData.nonIidResult = mainHist.nonIidResult;
+
+            for (int s = 0; s < 8; ++s) {
+                SubHistogram sub;
+                sub.rect.X.Min = 4000 + s * 200;
+                sub.rect.X.Max = 4100 + s * 200;
+                sub.color = ImVec4(0.84f, 0.28f, 0.28f, 0.25f);
+                sub.subHistIndex = s + 1;
+                sub.nonIidParsedResults.minEntropy = 0.4;
+                mainHist.subHists.push_back(sub);
+            }
+            project.operationalEnvironments.push_back(std::move(oe));
+        }
+        return project;
+    }
+
+    const char* const NON_IID_ESTIMATORS[NON_IID_ESTIMATOR_COUNT] = {
+        "Most Common Value", "Collision Test", "Markov Test", "Compression Test", "T-Tuple Test", "LRS Test",
+        "Multi Most Common in Window (MultiMCW) Prediction Test", "Lag Prediction Test",
+        "Multi Markov Model with Counting (MultiMMC) Prediction Test", "LZ78Y Prediction Test"
+    };
+
+    // Output shaped like ea_non_iid -v, including the per-estimator detail lines
+    std::string MakeNonIidLog(int seed) {
+        std::ostringstream log;
+        log << std::fixed << std::setprecision(6)
+            << "Opening file: 'samples_" << seed << ".bin' (SHA-256 hash 3f2a9c)\n"
+            << "Loaded 1000000 samples of 256 distinct 8-bit-wide symbols\n"
+            << "Number of Binary Symbols: 8000000\n\nRunning non-IID tests...\n\n";
+        for (size_t i = 0; i < NON_IID_ESTIMATOR_COUNT; ++i) {
+            const double jitter = ((seed * 31 + i * 7) % 97) / 9700.0;
+            log << "Running " << NON_IID_ESTIMATORS[i] << " Estimate...\n";
+            for (int detail = 0; detail < 4; ++detail) {
+                log << "Bitstring " << NON_IID_ESTIMATORS[i] << " Estimate: mode = " << 4000000 + seed + detail
+                    << ", p-hat = " << 0.5 + jitter << ", p_u = " << 0.5005 + jitter << "\n";
+            }
+            log << "\t" << NON_IID_ESTIMATORS[i] << " Estimate (bit string) = " << 0.99 - jitter << " / 1 bit(s)\n";
+            if (i < 2 || i > 3) log << "\t" << NON_IID_ESTIMATORS[i] << " Estimate = " << 7.9 - i * 0.1 - jitter << " / 8 bit(s)\n";
+            log << "\n";
+        }
+        log << "H_original: 7.000000\nH_bitstring: 0.900000\nmin(H_original, 8 X H_bitstring): 7.000000\n";
+        return log.str();
+    }
+
+    std::string MakeRestartLog(int seed) {
+        std::ostringstream log;
+        log << std::fixed << std::setprecision(6)
+            << "Opening file: 'restart_" << seed << ".bin' (SHA-256 hash 9b1e07)\n"
+            << "Loaded 1000000 samples of 256 distinct 8-bit-wide symbols\n"
+            << "H_I: 7.000000\nALPHA: 5.0251890762960547e-06, X_cutoff: 37\nX_max: " << 20 + seed % 10 << "\n"
+            << "\nRestart Sanity Check Passed...\n\nRunning non-IID tests...\n\n";
+        for (const char* dataset : { "rows", "columns" }) {
+            for (size_t i = 0; i < NON_IID_ESTIMATOR_COUNT; ++i) {
+                log << "Running " << NON_IID_ESTIMATORS[i] << " Estimate on " << dataset << "...\n"
+                    << "Literal " << NON_IID_ESTIMATORS[i] << " Estimate: mode = " << 3900 + seed % 100
+                    << ", p-hat = 0.0039, p_u = 0.0041\n";
+            }
+        }
+        log << "H_r: " << 7.1 + (seed % 5) / 100.0 << "\nH_c: 7.200000\nH_I: 7.000000\n"
+            << "Validation Test Passed...\n\nmin(H_r, H_c, H_I): 7.000000\n";
+        return log.str();
+    }
+
+    std::string MakeDecimationLog(int seed) {
+        std::ostringstream log;
+        log << "find-first-passing-decimation.pl version 1.0.2\n";
+        const int passing = 1 + seed % 12;
+        for (int rate = 1; rate <= passing; ++rate) {
+            log << "Testing decimation rate " << rate << "\n"
+                << "Running IID tests on decimated data (" << 1000000 / rate << " samples)...\n"
+                << "Chi-square independence: score = " << 2000 + rate << ", degrees of freedom = 2040, p-value = 0.43\n"
+                << "Chi-square goodness of fit: score = " << 90 + rate << ", degrees of freedom = 90, p-value = 0.49\n"
+                << "LRS test: W: 5, Pr(E>=1): 0.61\n"
+                << (rate == passing ? "IID permutation tests passed\n" : "IID permutation tests failed\n");
+        }
+        log << "The first passing decimation rate is " << passing << "\n";
+        return log.str();
+    }
+
+    std::string Format(const Result& r) {
+        std::ostringstream line;
+        line << std::left << std::setw(44) << r.name << std::right << std::fixed
+             << std::setw(11) << std::setprecision(3) << r.seconds * 1000.0 << " ms";
+        if (r.bytes)
+            line << std::setw(11) << std::setprecision(1) << (r.bytes / 1e6) / r.seconds << " MB/s";
+        else if (r.items)
+            line << std::setw(11) << std::setprecision(1) << r.seconds * 1e9 / r.items << " ns/item";
+        return line.str();
+    }
+
+    json ToJson(const std::vector<Result>& results) {
+        json j;
+        j["schema"] = 1;
+        j["hardwareConcurrency"] = std::thread::hardware_concurrency();
+        j["results"] = json::array();
+        for (const auto& r : results) {
+            json entry = { {"name", r.name}, {"seconds", r.seconds}, {"bytes", r.bytes}, {"items", r.items} };
+            if (r.bytes) entry["mbPerSec"] = (r.bytes / 1e6) / r.seconds;
+            if (r.items) entry["nsPerItem"] = r.seconds * 1e9 / r.items;
+            j["results"].push_back(entry);
+        }
+        return j;
+    }
+
+    // Returns the number of cases slower than baseline * (1 + threshold)
+    int CompareToBaseline(const std::vector<Result>& results, const fs::path& baselineFile, double threshold) {
+        std::ifstream in(baselineFile);
+        if (!in) {
+            std::cerr << "Cannot open baseline: " << baselineFile << "\n";
+            return 1;
+        }
+
+        json baseline;
+        try {
+            in >> baseline;
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to parse baseline: " << e.what() << "\n";
+            return 1;
+        }
+
+        int regressions = 0;
+        std::cout << "\nBaseline comparison (threshold " << threshold * 100.0 << "%):\n";
+        for (const auto& r : results) {
+            auto it = std::find_if(baseline["results"].begin(), baseline["results"].end(),
+                                   [&](const json& b) { return b.value("name", "") == r.name; });
+            if (it == baseline["results"].end()) {
+                std::cout << "  " << std::left << std::setw(44) << r.name << " (new)\n";
+                continue;
+            }
+
+            double base = it->value("seconds", 0.0);
+            if (base <= 0.0) continue;
+            double change = r.seconds / base - 1.0;
+            bool regressed = change > threshold;
+            regressions += regressed ? 1 : 0;
+
+            std::cout << "  " << std::left << std::setw(44) << r.name << std::right << std::fixed
+                      << std::setprecision(1) << std::showpos << std::setw(8) << change * 100.0 << "%"
+                      << std::noshowpos << (regressed ? "  REGRESSION" : "") << "\n";
+        }
+        return regressions;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opts;
+    if (!ParseArgs(argc, argv, opts)) {
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    std::error_code ec;
+    fs::create_directories(opts.workDir, ec);
+    if (ec) {
+        std::cerr << "Cannot create work directory " << opts.workDir << ": " << ec.message() << "\n";
+        return 1;
+    }
+
+    DataManager dataManager;
+    std::vector<Result> results;
+    auto report = [&results](Result r) {
+        std::cout << Format(r) << std::endl;
+        results.push_back(std::move(r));
+    };
+
+    // Parse + histogram build, versus sample count and thread count; conversion throughput
+    for (uint64_t count : opts.samples) {
+        fs::path input = opts.workDir / ("samples_" + std::to_string(count) + ".txt");
+        SampleGeneratorConfig generatorConfig;
+        generatorConfig.sampleCount = count;
+
+        std::optional<SampleGeneratorStats> generated;
+        double generateSeconds = TimeMedian(opts.repeat, [&] {
+            generated = GenerateSampleFile(input, generatorConfig);
+        });
+        if (!generated) return 1;
+        uint64_t bytes = generated->bytes;
+        report({ "generate/samples=" + std::to_string(count), generateSeconds, bytes, count });
+
+        // Single-threaded line parsing on each instruction set the CPU supports
+        {
+            std::ifstream in(input, std::ios::binary);
+            std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            const DecimalParser::Isa detected = DecimalParser::DetectIsa();
+            std::vector<int> values;
+
+            for (auto isa : { DecimalParser::Isa::Scalar, DecimalParser::Isa::Sse42, DecimalParser::Isa::Avx2 }) {
+                if (!DecimalParser::SetIsa(isa)) continue;
+                double seconds = TimeMedian(opts.repeat, [&] {
+                    values.clear();
+                    DecimalParser::ParseLines(content.data(), content.data() + content.size(), values);
+                    if (values.size() != count) std::cerr << "parse lost samples\n";
+                });
+                report({ "parse/samples=" + std::to_string(count) + "/isa=" + DecimalParser::IsaName(isa),
+                         seconds, bytes, count });
+            }
+            DecimalParser::SetIsa(detected);
+        }
+
+        for (unsigned int threads : opts.threads) {
+            double seconds = TimeMedian(opts.repeat, [&] {
+                MainHistogram hist = computeHistogramFromFile(input, threads);
+                if (hist.binCounts.empty()) std::cerr << "histogram build produced no data\n";
+            });
+            report({ "histogram/samples=" + std::to_string(count) + "/threads=" + std::to_string(threads),
+                     seconds, bytes, count });
+        }
+
+        double convertSeconds = TimeMedian(opts.repeat, [&] {
+            fs::path converted;
+            if (!dataManager.ConvertDecimalFile(input, converted)) std::cerr << "conversion failed\n";
+        });
+        report({ "convert/samples=" + std::to_string(count), convertSeconds, bytes, count });
+
+        fs::remove(input, ec);
+        fs::remove(opts.workDir / ("samples_" + std::to_string(count) + ".bin"), ec);
+    }
+
+    // Project persistence
+    {
+        fs::path projectRoot = opts.workDir / "project";
+        fs::remove_all(projectRoot, ec);
+        Project project = MakeProject(projectRoot, opts.oes);
+
+        double saveSeconds = TimeMedian(opts.repeat, [&] {
+            if (!dataManager.WriteProjectFiles(project)) std::cerr << "project save failed\n";
+        });
+        report({ "project_save/oes=" + std::to_string(opts.oes), saveSeconds, 0, static_cast<uint64_t>(opts.oes) });
+
+        fs::path projectFile = projectRoot / "project.json";
+        double loadSeconds = TimeMedian(opts.repeat, [&] {
+            Project loaded = dataManager.LoadProject(projectFile.string());
+            if (loaded.operationalEnvironments.size() != project.operationalEnvironments.size())
+                std::cerr << "project load lost OEs\n";
+        });
+        report({ "project_load/oes=" + std::to_string(opts.oes), loadSeconds, 0, static_cast<uint64_t>(opts.oes) });
+
+        // Whole-project snapshot copy (bins and result text are shared, not duplicated)
+        double copySeconds = TimeMedian(opts.repeat, [&] {
+            Project snapshot = project;
+            if (snapshot.operationalEnvironments.size() != project.operationalEnvironments.size())
+                std::cerr << "project copy lost OEs\n";
+        });
+        report({ "project_copy/oes=" + std::to_string(opts.oes), copySeconds, 0, static_cast<uint64_t>(opts.oes) });
+
+        fs::remove_all(projectRoot, ec);
+    }
+
+    // Re-parsing stored tool logs, as when building reports across projects
+    {
+        std::vector<std::string> nonIidLogs, restartLogs, decimationLogs;
+        for (int i = 0; i < opts.logs; ++i) {
+            nonIidLogs.push_back(MakeNonIidLog(i));
+            restartLogs.push_back(MakeRestartLog(i));
+            decimationLogs.push_back(MakeDecimationLog(i));
+        }
+        auto totalBytes = [](const std::vector<std::string>& logs) {
+            uint64_t bytes = 0;
+            for (const auto& log : logs) bytes += log.size();
+            return bytes;
+        };
+        const std::string suffix = "/logs=" + std::to_string(opts.logs);
+        const uint64_t logCount = static_cast<uint64_t>(opts.logs);
+
+        double seconds = TimeMedian(opts.repeat, [&] {
+            for (const auto& log : nonIidLogs) {
+                const NonIidReport parsed = ParseNonIid(log);
+                if (!parsed.Complete() || parsed.estimates.size() != NON_IID_ESTIMATOR_COUNT) std::cerr << "non-IID parse incomplete\n";
+            }
+        });
+        report({ "result_parse/non_iid" + suffix, seconds, totalBytes(nonIidLogs), logCount });
+
+        seconds = TimeMedian(opts.repeat, [&] {
+            for (const auto& log : restartLogs) {
+                if (!ParseRestart(log).Passed()) std::cerr << "restart parse incomplete\n";
+            }
+        });
+        report({ "result_parse/restart" + suffix, seconds, totalBytes(restartLogs), logCount });
+
+        seconds = TimeMedian(opts.repeat, [&] {
+            for (const auto& log : decimationLogs) {
+                if (ParseDecimation(log).Outcome() != DecimationOutcome::Passed) std::cerr << "decimation parse incomplete\n";
+            }
+        });
+        report({ "result_parse/decimation" + suffix, seconds, totalBytes(decimationLogs), logCount });
+    }
+
+    // ThreadPool per-task overhead (enqueue, dispatch, future)
+    for (unsigned int threads : opts.threads) {
+        ThreadPool pool(threads);
+        std::atomic<uint64_t> sink{0};
+        std::vector<std::future<void>> futures;
+        futures.reserve(opts.tasks);
+
+        double seconds = TimeMedian(opts.repeat, [&] {
+            for (int t = 0; t < opts.tasks; ++t) {
+                futures.push_back(pool.Enqueue([&sink, t] { sink.fetch_add(t, std::memory_order_relaxed); }));
+            }
+            for (auto& f : futures) f.get();
+        }, [&] { futures.clear(); });
+        report({ "thread_pool/tasks=" + std::to_string(opts.tasks) + "/threads=" + std::to_string(threads),
+                 seconds, 0, static_cast<uint64_t>(opts.tasks) });
+    }
+
+    if (!opts.outFile.empty()) {
+        std::ofstream out(opts.outFile, std::ios::out | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Failed to write results: " << opts.outFile << "\n";
+            return 1;
+        }
+        out << ToJson(results).dump(4);
+    } else {
+        std::cout << "\n" << ToJson(results).dump(4) << std::endl;
+    }
+
+    if (!opts.baselineFile.empty()) {
+        int regressions = CompareToBaseline(results, opts.baselineFile, opts.threshold);
+        if (regressions > 0) {
+            std::cerr << regressions << " case(s) regressed beyond the threshold\n";
+            return 1;
+        }
+    }
+
+    return 0;
+}
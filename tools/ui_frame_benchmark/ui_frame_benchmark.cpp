@@ -0,0 +1,555 @@
+
+// Headless UI frame benchmark: renders UIManager against a synthetic project with
+// no window and no GPU, and reports the CPU cost and allocations of each frame.
+//
+//   EntropyAnalysisUiBenchmark [--oes N] [--regions N] [--catalog N] [--frames N]
+//                              [--warmup N] [--size WxH] [--scenarios a,b,...]
+//                              [--out results.json] [--baseline baseline.json] [--threshold 0.10]
+//
+// Every scenario (a tab, or a popup over it) gets fresh ImGui/ImPlot contexts and a
+// fresh UIManager, runs --warmup untimed frames so windows and popups settle, then
+// --frames timed ones. A frame is NewFrame + UIManager::Render + ImGui::Render; the
+// draw data is dropped. Allocations are counted through global operator new and
+// ImGui's allocator hooks. Results and --baseline use the same JSON shape as
+// EntropyAnalysisBenchmark, compared on median CPU time per frame.
+
+#include "../../src/core/config.h"
+#include "../../src/data/data_manager.h"
+#include "../../src/data/value_index/value_index.h"
+#include "../../src/ui/ui_manager.h"
+
+#include <imgui.h>
+#include <implot.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+// --- Allocation counting ---------------------------------------------------------
+
+namespace {
+    std::atomic<uint64_t> g_allocations{ 0 };
+    std::atomic<uint64_t> g_allocatedBytes{ 0 };
+
+    void* CountedAlloc(size_t size) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        return std::malloc(size ? size : 1);
+    }
+
+    void* CountedAlignedAlloc(size_t size, std::align_val_t align) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+#ifdef _WIN32
+        return _aligned_malloc(size ? size : 1, static_cast<size_t>(align));
+#else
+        const size_t alignment = static_cast<size_t>(align);
+        return std::aligned_alloc(alignment, (std::max<size_t>(size, 1) + alignment - 1) / alignment * alignment);
+#endif
+    }
+
+    // Kept out of line: once a replaced operator delete is inlined into its
+    // caller, GCC sees free() on a pointer from operator new and warns
+    // (-Wmismatched-new-delete), though both sides are ours and match
+#if defined(__GNUC__)
+    __attribute__((noinline))
+#endif
+    void Free(void* ptr) { std::free(ptr); }
+
+#if defined(__GNUC__)
+    __attribute__((noinline))
+#endif
+    void AlignedFree(void* ptr) {
+#ifdef _WIN32
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+
+    void* ImGuiCountedAlloc(size_t size, void*) { return CountedAlloc(size); }
+    void ImGuiFree(void* ptr, void*) { std::free(ptr); }
+}
+
+// Every form of global new is replaced so each one is counted, and every form
+// of delete so each releases memory the way its new obtained it
+void* operator new(size_t size) {
+    if (void* ptr = CountedAlloc(size)) return ptr;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size) {
+    if (void* ptr = CountedAlloc(size)) return ptr;
+    throw std::bad_alloc();
+}
+void* operator new(size_t size, std::align_val_t align) {
+    if (void* ptr = CountedAlignedAlloc(size, align)) return ptr;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size, std::align_val_t align) {
+    if (void* ptr = CountedAlignedAlloc(size, align)) return ptr;
+    throw std::bad_alloc();
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return CountedAlloc(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return CountedAlloc(size); }
+void* operator new(size_t size, std::align_val_t align, const std::nothrow_t&) noexcept { return CountedAlignedAlloc(size, align); }
+void* operator new[](size_t size, std::align_val_t align, const std::nothrow_t&) noexcept { return CountedAlignedAlloc(size, align); }
+
+void operator delete(void* ptr) noexcept { Free(ptr); }
+void operator delete[](void* ptr) noexcept { Free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { Free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { Free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { Free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { Free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { AlignedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { AlignedFree(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { AlignedFree(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { AlignedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { AlignedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { AlignedFree(ptr); }
+
+// --- Benchmark -------------------------------------------------------------------
+
+namespace {
+    struct Options {
+        int oes = 64;
+        int regions = 8;        // per OE
+        int catalog = 500;      // saved projects listed by the Load Project popup
+        int frames = 300;
+        int warmup = 10;
+        float width = 1600.0f;
+        float height = 900.0f;
+        std::vector<std::string> scenarios;     // empty = all
+        double threshold = 0.10;
+        fs::path outFile;
+        fs::path baselineFile;
+    };
+
+    struct Scenario {
+        std::string name;
+        std::function<void(UIManager&)> open;   // applied before every frame, as a click would leave it
+    };
+
+    struct Result {
+        std::string name;
+        int frames = 0;
+        double cpuMedian = 0.0;     // seconds per frame
+        double cpuP95 = 0.0;
+        double wallMedian = 0.0;
+        double allocationsPerFrame = 0.0;
+        double bytesPerFrame = 0.0;
+    };
+
+    std::vector<std::string> SplitList(const std::string& list) {
+        std::vector<std::string> items;
+        std::stringstream stream(list);
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            if (!item.empty()) items.push_back(item);
+        }
+        return items;
+    }
+
+    bool ParseArgs(int argc, char** argv, Options& opts) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            auto take = [&]() { ++i; return std::string(value); };
+
+            if (arg == "-h" || arg == "--help") return false;
+            if (!value) {
+                std::cerr << "Missing value for " << arg << "\n";
+                return false;
+            }
+
+            if (arg == "--oes") {
+                opts.oes = std::max(1, std::stoi(take()));
+            } else if (arg == "--regions") {
+                opts.regions = std::max(0, std::stoi(take()));
+            } else if (arg == "--catalog") {
+                opts.catalog = std::max(0, std::stoi(take()));
+            } else if (arg == "--frames") {
+                opts.frames = std::max(1, std::stoi(take()));
+            } else if (arg == "--warmup") {
+                opts.warmup = std::max(0, std::stoi(take()));
+            } else if (arg == "--size") {
+                std::string size = take();
+                size_t x = size.find('x');
+                if (x == std::string::npos) {
+                    std::cerr << "Expected WxH for --size\n";
+                    return false;
+                }
+                opts.width = std::stof(size.substr(0, x));
+                opts.height = std::stof(size.substr(x + 1));
+            } else if (arg == "--scenarios") {
+                opts.scenarios = SplitList(take());
+            } else if (arg == "--out") {
+                opts.outFile = take();
+            } else if (arg == "--baseline") {
+                opts.baselineFile = take();
+            } else if (arg == "--threshold") {
+                opts.threshold = std::stod(take());
+            } else {
+                std::cerr << "Unknown argument: " << arg << "\n";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void PrintUsage(const char* argv0) {
+        std::cerr << "Usage: " << argv0 << " [--oes N] [--regions N] [--catalog N] [--frames N] [--warmup N]\n"
+                  << "       [--size WxH] [--scenarios a,b,...] [--out FILE] [--baseline FILE] [--threshold F]\n";
+    }
+
+    double ThreadCpuSeconds() {
+#ifdef _WIN32
+        FILETIME creation, exit, kernel, user;
+        GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user);
+        auto ticks = [](const FILETIME& t) { return (static_cast<uint64_t>(t.dwHighDateTime) << 32) | t.dwLowDateTime; };
+        return (ticks(kernel) + ticks(user)) * 1e-7;
+#else
+        timespec ts;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+    }
+
+    double Percentile(std::vector<double> values, double p) {
+        std::sort(values.begin(), values.end());
+        size_t index = static_cast<size_t>(std::lround(p * (values.size() - 1)));
+        return values[index];
+    }
+
+    // Large synthetic project, shaped like real data: smoothed bins, a value index,
+    // regions with results and a few hundred KiB of tool output per OE
+    Project MakeProject(const Options& opts) {
+        Project project;
+        project.vendor = "bench";
+        project.repo = "bench";
+        project.name = "ui_bench";
+        project.path = (fs::temp_directory_path() / "eat_ui_benchmark").string();
+
+        std::vector<int64_t> values;
+        std::vector<uint64_t> counts;
+        for (int v = 3000; v < 7000; ++v) {
+            values.push_back(v);
+            counts.push_back(static_cast<uint64_t>(100000.0 * std::exp(-0.5 * std::pow((v - 5000) / 400.0, 2)) + 1));
+        }
+        const auto valueIndex = ValueIndex::FromCounts(values, counts);
+        // Shaped like verbose ea_non_iid output: about 4 MiB of short lines
+        std::string verboseLog;
+        for (int line = 0; verboseLog.size() < (4u << 20); ++line) {
+            verboseLog += "Literal MCV Estimate: mode = " + std::to_string(line) + ", p-hat = 0.0123456789, p_u = 0.0125\n";
+        }
+        const SharedText resultText = std::move(verboseLog);
+
+        for (int i = 0; i < opts.oes; ++i) {
+            OperationalEnvironment oe;
+            oe.oeName = "OE_" + std::to_string(i);
+            oe.oePath = "OE/" + oe.oeName;
+
+            auto& mainHist = oe.heuristicData.mainHistogram;
+            mainHist.heuristicFilePath = fs::path(project.path) / oe.oePath / "samples.txt";
+            mainHist.convertedFilePath = fs::path(project.path) / oe.oePath / "samples.bin";
+            mainHist.minValue = 3400;
+            mainHist.maxValue = 6600;
+            mainHist.binWidth = 3200.0 / MainHistogram::defaultBinCount;
+            std::vector<int> bins(MainHistogram::defaultBinCount);
+            for (int b = 0; b < MainHistogram::defaultBinCount; ++b) {
+                double x = mainHist.minValue + (b + 0.5) * mainHist.binWidth;
+                bins[b] = static_cast<int>(valueIndex->CountInRange(x - mainHist.binWidth / 2, x + mainHist.binWidth / 2));
+            }
+            mainHist.binCounts = std::move(bins);
+            smoothHistogram(mainHist);
+            mainHist.valueIndex = valueIndex;
+            mainHist.nonIidParsedResults.minEntropy = 0.5;
+            mainHist.firstPassingDecimationResult = "Passed: Found passing decimation rate: 4";
+            mainHist.nonIidResult = resultText;
+
+            oe.statisticData.nonIidSampleFilePath = mainHist.convertedFilePath;
+            oe.statisticData.nonIidResult = resultText;
+            oe.statisticData.restartResult = resultText;
+            oe.statisticData.nonIidParsedResults.minEntropy = 0.5;
+
+            for (int r = 0; r < opts.regions; ++r) {
+                SubHistogram sub;
+                sub.rect.X.Min = 3500 + r * (3000.0 / std::max(1, opts.regions));
+                sub.rect.X.Max = sub.rect.X.Min + 100;
+                sub.minValue = static_cast<unsigned int>(sub.rect.X.Min);
+                sub.maxValue = static_cast<unsigned int>(sub.rect.X.Max);
+                sub.color = ImVec4(0.84f, 0.28f, 0.28f, 0.25f);
+                sub.subHistIndex = r + 1;
+                sub.nonIidParsedResults.minEntropy = 0.4;
+                mainHist.subHists.push_back(sub);
+            }
+            project.operationalEnvironments.push_back(std::move(oe));
+        }
+        return project;
+    }
+
+    Config::AppConfig MakeAppConfig(const Options& opts, const Project& project) {
+        Config::AppConfig config;
+        config.vendorsList = { "bench", "vendor_a", "vendor_b" };
+        config.savedProjects.Upsert(project);
+        for (int i = 0; i < opts.catalog; ++i) {
+            Project entry;
+            entry.vendor = config.vendorsList[i % config.vendorsList.size()];
+            entry.repo = "repo_" + std::to_string(i % 37);
+            entry.name = "project_" + std::to_string(i);
+            entry.path = "projects/" + entry.name;
+            config.savedProjects.Upsert(entry);
+        }
+        config.lastOpenedProject = ProjectCatalog::EntryFor(project);
+        return config;
+    }
+
+    std::vector<Scenario> AllScenarios() {
+        auto tab = [](Tabs t) {
+            return [t](UIManager& ui) {
+                ui.GetUIState().activeTab = t;
+                ui.GetUIState().selectedOEIndex = 0;
+            };
+        };
+        auto over = [](Tabs t, std::function<void(UIManager&)> open) {
+            return [t, open](UIManager& ui) {
+                ui.GetUIState().activeTab = t;
+                ui.GetUIState().selectedOEIndex = 0;
+                open(ui);
+            };
+        };
+
+        return {
+            { "tab/statistic", tab(Tabs::StatisticalAssessment) },
+            { "tab/heuristic", tab(Tabs::HeuristicAssessment) },
+            { "popup/new_project", over(Tabs::StatisticalAssessment, [](UIManager& ui) { ui.GetUIState().newProjectPopupOpen = true; }) },
+            { "popup/load_project", over(Tabs::StatisticalAssessment, [](UIManager& ui) { ui.GetUIState().loadProjectPopupOpen = true; }) },
+            { "popup/add_oe", over(Tabs::StatisticalAssessment, [](UIManager& ui) { ui.GetUIState().addOEPopupOpen = true; }) },
+            { "popup/edit_oe", over(Tabs::StatisticalAssessment, [](UIManager& ui) { ui.GetUIState().editOEPopupOpen = true; }) },
+            { "popup/file_converter", over(Tabs::StatisticalAssessment, [](UIManager& ui) { ui.GetUIState().showFileConverterPopup = true; }) },
+            { "popup/help", over(Tabs::StatisticalAssessment, [](UIManager& ui) { ui.GetUIState().showHelpWindow = true; }) },
+            { "popup/batch_statistic", over(Tabs::StatisticalAssessment, [](UIManager& ui) { ui.GetStatisticManager().m_showBatchPopup = true; }) },
+            { "popup/batch_heuristic", over(Tabs::HeuristicAssessment, [](UIManager& ui) { ui.GetHeuristicManager().m_showBatchPopup = true; }) },
+            { "popup/edit_histogram", over(Tabs::HeuristicAssessment, [](UIManager& ui) { ui.GetHeuristicManager().OpenEditHistogramPopup(); }) },
+        };
+    }
+
+    Result RunScenario(const Scenario& scenario, const Options& opts, DataManager& dataManager) {
+        // Fresh project and config per scenario: popups may edit either
+        Project project = MakeProject(opts);
+        Config::AppConfig config = MakeAppConfig(opts, project);
+
+        ImGui::CreateContext();
+        ImPlot::CreateContext();
+        ImGuiIO& io = ImGui::GetIO();
+        io.IniFilename = nullptr;
+        io.LogFilename = nullptr;
+        io.DisplaySize = ImVec2(opts.width, opts.height);
+        io.DeltaTime = 1.0f / 60.0f;
+
+        // Null renderer: the font atlas only has to exist, nothing is uploaded
+        ImFont* font = io.Fonts->AddFontDefault();
+        for (ImFont** slot : { &Config::fontH1, &Config::fontH1_Bold, &Config::fontH2, &Config::fontH2_Bold,
+                               &Config::fontH3, &Config::fontH3_Bold, &Config::normal, &Config::icons }) {
+            *slot = font;
+        }
+        unsigned char* pixels = nullptr;
+        int texWidth = 0, texHeight = 0;
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &texWidth, &texHeight);
+        io.Fonts->SetTexID((ImTextureID)(intptr_t)1);
+        ImGui::StyleColorsDark();
+
+        CommandQueue queue;
+        auto ui = std::make_unique<UIManager>(queue);
+        ui->Initialize(&dataManager, &config, &project);
+        ui->OnProjectChanged(project);
+
+        std::vector<double> cpu, wall;
+        cpu.reserve(opts.frames);
+        wall.reserve(opts.frames);
+        uint64_t allocations = 0, bytes = 0;
+
+        for (int frame = 0; frame < opts.warmup + opts.frames; ++frame) {
+            scenario.open(*ui);
+
+            const uint64_t allocBefore = g_allocations.load(std::memory_order_relaxed);
+            const uint64_t bytesBefore = g_allocatedBytes.load(std::memory_order_relaxed);
+            const double cpuStart = ThreadCpuSeconds();
+            const auto wallStart = std::chrono::steady_clock::now();
+
+            ImGui::NewFrame();
+            ui->Render();
+            ImGui::Render();
+
+            const auto wallEnd = std::chrono::steady_clock::now();
+            const double cpuEnd = ThreadCpuSeconds();
+
+            if (frame >= opts.warmup) {
+                cpu.push_back(cpuEnd - cpuStart);
+                wall.push_back(std::chrono::duration<double>(wallEnd - wallStart).count());
+                allocations += g_allocations.load(std::memory_order_relaxed) - allocBefore;
+                bytes += g_allocatedBytes.load(std::memory_order_relaxed) - bytesBefore;
+            }
+
+            // Commands a popup may have queued (save, delete...) are not executed
+            AppCommand cmd;
+            while (queue.Pop(cmd)) {}
+        }
+
+        ui.reset();
+        ImPlot::DestroyContext();
+        ImGui::DestroyContext();
+
+        Result r;
+        r.name = scenario.name + "/oes=" + std::to_string(opts.oes) + "/regions=" + std::to_string(opts.regions);
+        r.frames = opts.frames;
+        r.cpuMedian = Percentile(cpu, 0.5);
+        r.cpuP95 = Percentile(cpu, 0.95);
+        r.wallMedian = Percentile(wall, 0.5);
+        r.allocationsPerFrame = static_cast<double>(allocations) / opts.frames;
+        r.bytesPerFrame = static_cast<double>(bytes) / opts.frames;
+        return r;
+    }
+
+    std::string Format(const Result& r) {
+        std::ostringstream line;
+        line << std::left << std::setw(52) << r.name << std::right << std::fixed
+             << std::setw(9) << std::setprecision(1) << r.cpuMedian * 1e6 << " us"
+             << std::setw(9) << std::setprecision(1) << r.cpuP95 * 1e6 << " us p95"
+             << std::setw(9) << std::setprecision(1) << r.allocationsPerFrame << " allocs"
+             << std::setw(11) << std::setprecision(0) << r.bytesPerFrame << " B/frame";
+        return line.str();
+    }
+
+    json ToJson(const std::vector<Result>& results, const Options& opts) {
+        json j;
+        j["schema"] = 1;
+        j["display"] = { opts.width, opts.height };
+        j["results"] = json::array();
+        for (const auto& r : results) {
+            j["results"].push_back({
+                {"name", r.name},
+                {"seconds", r.cpuMedian},       // baseline comparisons use this, as in the pipeline benchmark
+                {"cpuP95", r.cpuP95},
+                {"wallMedian", r.wallMedian},
+                {"frames", r.frames},
+                {"allocationsPerFrame", r.allocationsPerFrame},
+                {"bytesPerFrame", r.bytesPerFrame}
+            });
+        }
+        return j;
+    }
+
+    // Returns the number of scenarios slower than baseline * (1 + threshold)
+    int CompareToBaseline(const std::vector<Result>& results, const fs::path& baselineFile, double threshold) {
+        std::ifstream in(baselineFile);
+        if (!in) {
+            std::cerr << "Cannot open baseline: " << baselineFile << "\n";
+            return 1;
+        }
+
+        json baseline;
+        try {
+            in >> baseline;
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to parse baseline: " << e.what() << "\n";
+            return 1;
+        }
+
+        int regressions = 0;
+        std::cout << "\nBaseline comparison (threshold " << threshold * 100.0 << "%):\n";
+        for (const auto& r : results) {
+            auto it = std::find_if(baseline["results"].begin(), baseline["results"].end(),
+                                   [&](const json& b) { return b.value("name", "") == r.name; });
+            if (it == baseline["results"].end()) {
+                std::cout << "  " << std::left << std::setw(52) << r.name << " (new)\n";
+                continue;
+            }
+
+            double base = it->value("seconds", 0.0);
+            if (base <= 0.0) continue;
+            double change = r.cpuMedian / base - 1.0;
+            bool regressed = change > threshold;
+            regressions += regressed ? 1 : 0;
+
+            std::cout << "  " << std::left << std::setw(52) << r.name << std::right << std::fixed
+                      << std::setprecision(1) << std::showpos << std::setw(8) << change * 100.0 << "%"
+                      << std::noshowpos << (regressed ? "  REGRESSION" : "") << "\n";
+        }
+        return regressions;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opts;
+    if (!ParseArgs(argc, argv, opts)) {
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    ImGui::SetAllocatorFunctions(ImGuiCountedAlloc, ImGuiFree);
+
+    std::vector<Scenario> scenarios = AllScenarios();
+    if (!opts.scenarios.empty()) {
+        std::vector<Scenario> selected;
+        for (const auto& name : opts.scenarios) {
+            auto it = std::find_if(scenarios.begin(), scenarios.end(), [&](const Scenario& s) { return s.name == name; });
+            if (it == scenarios.end()) {
+                std::cerr << "Unknown scenario: " << name << "\n";
+                return 2;
+            }
+            selected.push_back(*it);
+        }
+        scenarios = std::move(selected);
+    }
+
+    DataManager dataManager;    // never initialised: nothing here may touch the user's app config
+    std::vector<Result> results;
+    for (const auto& scenario : scenarios) {
+        Result r = RunScenario(scenario, opts, dataManager);
+        std::cout << Format(r) << std::endl;
+        results.push_back(std::move(r));
+    }
+
+    if (!opts.outFile.empty()) {
+        std::ofstream out(opts.outFile, std::ios::out | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Failed to write results: " << opts.outFile << "\n";
+            return 1;
+        }
+        out << ToJson(results, opts).dump(4);
+    } else {
+        std::cout << "\n" << ToJson(results, opts).dump(4) << std::endl;
+    }
+
+    if (!opts.baselineFile.empty()) {
+        int regressions = CompareToBaseline(results, opts.baselineFile, opts.threshold);
+        if (regressions > 0) {
+            std::cerr << regressions << " scenario(s) regressed beyond the threshold\n";
+            return 1;
+        }
+    }
+
+    return 0;
+}